@@ -0,0 +1,295 @@
+/**
+  * BatchSolver.cpp
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This is an implementation of BatchSolver.h.
+  * 		 For an explanation of the class, please consult that file.
+  */
+
+#include "BatchSolver.h"
+#include "Cell.h"
+#include "KakuroConfig.h"
+#include "Partitioner.h"
+#include "PuzzleCheck.h"
+#include "RunIndex.h"
+#include "Solver.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Defined here since min binds it by reference
+const unsigned BatchSolver::maxLanes;
+
+BatchSolver::BatchSolver(const vector<vector<vector<Cell>>>& boards) :
+	m_boards(boards), m_runs(boards.front()), m_active(0), m_dead(0), m_domains(m_runs.height() * m_runs.width()), m_combos(m_runs.runs().size()) {
+	for(unsigned lane = 0; lane < m_boards.size(); ++lane) m_active |= Lanes(1) << lane;
+	
+	// Empty cells may take anything to begin with; filled ones only their value
+	for(unsigned i = 0; i < m_runs.height(); ++i) {
+		for(unsigned j = 0; j < m_runs.width(); ++j) {
+			array<Lanes, 9>& domain = m_domains[m_runs.index(i, j)];
+			
+			for(unsigned lane = 0; lane < m_boards.size(); ++lane) {
+				const Cell& c = m_boards[lane][i][j];
+				if(!c.isValueCell()) continue;
+				
+				for(int v = 1; v <= 9; ++v) {
+					if(c.value() == 0 || c.value() == v) domain[v - 1] |= Lanes(1) << lane;
+				}
+			}
+		}
+	}
+	
+	// A run may take any combination of its length that adds up to its sum in some lane
+	for(unsigned run = 0; run < m_runs.runs().size(); ++run) {
+		const Run& r = m_runs.runs()[run];
+		map<unsigned short, Lanes> alive;
+		
+		for(unsigned lane = 0; lane < m_boards.size(); ++lane) {
+			int sum = runSum(lane, r);
+			
+			// Unrestricted runs only need distinct values, which any combination of the right size has
+			int low = sum > 0 ? sum : 0, high = sum > 0 ? sum : 45;
+			
+			for(int s = low; s <= high; ++s) {
+				for(unsigned short mask : Partitioner::getInstance().subsets(s, r.cells.size())) alive[mask] |= Lanes(1) << lane;
+			}
+		}
+		
+		for(const pair<const unsigned short, Lanes>& combo : alive) {
+			m_combos[run].masks.push_back(combo.first);
+			m_combos[run].alive.push_back(combo.second);
+		}
+	}
+}
+
+int BatchSolver::runSum(unsigned lane, const Run& run) const {
+	// A run starts right of or below its sum cell
+	unsigned first = run.cells.front();
+	unsigned i = first / m_runs.width(), j = first % m_runs.width();
+	
+	return run.horizontal ? m_boards[lane][i][j - 1].rightSum() : m_boards[lane][i - 1][j].downSum();
+}
+
+bool BatchSolver::propagateRun(const Run& run, RunCombos& combos) {
+	unsigned length = run.cells.size();
+	
+	// Per value, the lanes in which some cell of the run can still take it
+	array<Lanes, 9> placeable{};
+	for(unsigned index : run.cells) {
+		for(int v = 0; v < 9; ++v) placeable[v] |= m_domains[index][v];
+	}
+	
+	// A combination survives where each of its values has a cell to go to and each cell has one of its values to take
+	array<Lanes, 9> allowed{}, lacking{};
+	Lanes feasible(0);
+	
+	for(unsigned k = 0; k < combos.masks.size(); ++k) {
+		unsigned mask = combos.masks[k];
+		Lanes alive = combos.alive[k];
+		
+		for(int v = 0; v < 9 && alive; ++v) {
+			if(mask & (1 << v)) alive &= placeable[v];
+		}
+		
+		for(unsigned c = 0; c < length && alive; ++c) {
+			Lanes takes(0);
+			for(int v = 0; v < 9; ++v) {
+				if(mask & (1 << v)) takes |= m_domains[run.cells[c]][v];
+			}
+			
+			alive &= takes;
+		}
+		
+		combos.alive[k] = alive;
+		feasible |= alive;
+		
+		for(int v = 0; v < 9; ++v) {
+			if(mask & (1 << v)) {
+				allowed[v] |= alive;
+			} else {
+				lacking[v] |= alive;
+			}
+		}
+	}
+	
+	// Lanes without a feasible combination can't be solved
+	m_dead |= m_active & ~feasible;
+	
+	bool changed(false);
+	
+	for(int v = 0; v < 9; ++v) {
+		// Every cell must take a value some combination still allows
+		for(unsigned index : run.cells) {
+			Lanes narrowed = m_domains[index][v] & allowed[v];
+			
+			if(narrowed != m_domains[index][v]) {
+				m_domains[index][v] = narrowed;
+				changed = true;
+			}
+		}
+		
+		// A value every feasible combination needs must go in the one cell that can take it, if there is only one
+		Lanes required = feasible & ~lacking[v];
+		Lanes seen(0), repeated(0);
+		
+		for(unsigned index : run.cells) {
+			repeated |= seen & m_domains[index][v];
+			seen |= m_domains[index][v];
+		}
+		
+		m_dead |= required & ~seen;
+		
+		Lanes forced = required & seen & ~repeated;
+		if(!forced) continue;
+		
+		for(unsigned index : run.cells) {
+			Lanes only = forced & m_domains[index][v];
+			if(!only) continue;
+			
+			for(int w = 0; w < 9; ++w) {
+				if(w != v && (m_domains[index][w] & only)) {
+					m_domains[index][w] &= ~only;
+					changed = true;
+				}
+			}
+		}
+	}
+	
+	// A cell down to one value takes it away from the rest of the run
+	for(unsigned c = 0; c < length; ++c) {
+		array<Lanes, 9>& domain = m_domains[run.cells[c]];
+		
+		Lanes seen(0), repeated(0);
+		for(int v = 0; v < 9; ++v) {
+			repeated |= seen & domain[v];
+			seen |= domain[v];
+		}
+		
+		m_dead |= m_active & ~seen;
+		
+		Lanes single = seen & ~repeated;
+		if(!single) continue;
+		
+		for(int v = 0; v < 9; ++v) {
+			Lanes settled = single & domain[v];
+			if(!settled) continue;
+			
+			for(unsigned peer = 0; peer < length; ++peer) {
+				if(peer != c && (m_domains[run.cells[peer]][v] & settled)) {
+					m_domains[run.cells[peer]][v] &= ~settled;
+					changed = true;
+				}
+			}
+		}
+	}
+	
+	return changed;
+}
+
+void BatchSolver::propagate() {
+	bool changed(true);
+	
+	// Stop early once every lane is dead
+	while(changed && (m_active & ~m_dead)) {
+		changed = false;
+		
+		for(unsigned run = 0; run < m_runs.runs().size(); ++run) {
+			if(propagateRun(m_runs.runs()[run], m_combos[run])) changed = true;
+		}
+	}
+}
+
+vector<vector<Cell>> BatchSolver::laneBoard(unsigned lane) const {
+	vector<vector<Cell>> board = m_boards[lane];
+	Lanes bit = Lanes(1) << lane;
+	
+	for(unsigned i = 0; i < m_runs.height(); ++i) {
+		for(unsigned j = 0; j < m_runs.width(); ++j) {
+			Cell& c = board[i][j];
+			if(!c.isValueCell() || c.value() != 0) continue;
+			
+			const array<Lanes, 9>& domain = m_domains[m_runs.index(i, j)];
+			int value(0), count(0);
+			
+			for(int v = 0; v < 9; ++v) {
+				if(domain[v] & bit) {
+					value = v + 1;
+					++count;
+				}
+			}
+			
+			if(count == 1) c = Cell(value, false);
+		}
+	}
+	
+	return board;
+}
+
+string BatchSolver::shapeOf(const vector<vector<Cell>>& board) {
+	string shape = to_string(board.size()) + "x" + to_string(board.empty() ? 0 : board[0].size()) + ":";
+	
+	for(const vector<Cell>& row : board) {
+		for(const Cell& c : row) shape += c.isValueCell() ? 'v' : 's';
+	}
+	
+	return shape;
+}
+
+vector<BatchResult> BatchSolver::solve(const vector<vector<vector<Cell>>>& boards, const SearchOptions& options, const SolverLimits& limits) {
+	vector<BatchResult> results(boards.size(), BatchResult{SolveStatus::Unsolvable, vector<vector<Cell>>(), false, 0});
+	
+	// Group the boards by shape, keeping their positions so results go back in order (unreadable boards, and those whose clues can't add up, are left unsolvable)
+	map<string, vector<unsigned>> shapes;
+	for(unsigned k = 0; k < boards.size(); ++k) {
+		if(checkPuzzle(boards[k]).empty()) shapes[shapeOf(boards[k])].push_back(k);
+	}
+	
+	for(const pair<const string, vector<unsigned>>& shape : shapes) {
+		const vector<unsigned>& members = shape.second;
+		
+		for(unsigned start = 0; start < members.size(); start += maxLanes) {
+			unsigned count = min<unsigned>(maxLanes, members.size() - start);
+			
+			vector<vector<vector<Cell>>> batch;
+			for(unsigned lane = 0; lane < count; ++lane) batch.push_back(boards[members[start + lane]]);
+			
+			BatchSolver solver(batch);
+			solver.propagate();
+			
+			for(unsigned lane = 0; lane < count; ++lane) {
+				BatchResult& result = results[members[start + lane]];
+				if(solver.m_dead & (Lanes(1) << lane)) continue;
+				
+				vector<vector<Cell>> board = solver.laneBoard(lane);
+				
+				if(KakuroConfig::isSolution(board)) {
+					result.status = SolveStatus::Solved;
+					result.solution = board;
+					continue;
+				}
+				
+				// Propagation fell short, so this lane branches on its own from where propagation left it
+				shared_ptr<KakuroConfig> config = make_shared<KakuroConfig>(board, false);
+				config->setSearchOptions(options);
+				
+				Solver<KakuroConfig> search(config, limits);
+				
+				result.status = search.status();
+				result.searched = true;
+				result.nodes = search.numNodes();
+				
+				if(search.status() == SolveStatus::Solved) result.solution = search.getSolutionPath().front()->getBoard();
+			}
+		}
+	}
+	
+	return results;
+}
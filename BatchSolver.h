@@ -0,0 +1,91 @@
+/**
+  * BatchSolver.h
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This class propagates a batch of puzzles with the same grid shape in lockstep, one puzzle per bit of a 64-bit word.
+  *		 Each cell keeps, per value, the set of puzzles (lanes) in which that value is still possible; each run keeps, per value combination, the lanes in which it's still feasible.
+  *		 Propagation (combinations against domains, values every combination needs, and values a filled cell takes from its peers) is done with bitwise operations on whole words, so it costs the same for one lane as for 64.
+  *		 Most easy puzzles are settled by propagation alone; only lanes that still need to branch are handed to the scalar Solver, starting from what propagation found.
+  *		 Puzzles are grouped by shape (which cells are value cells), so any mix of puzzles can be given at once.
+  */
+
+#ifndef KBATCH_H
+#define KBATCH_H
+
+#include "Cell.h"
+#include "RunIndex.h"
+#include "SearchContext.h"
+#include "Solver.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// What became of one puzzle of a batch
+struct BatchResult {
+	SolveStatus status;
+	
+	// The solved board (empty unless solved)
+	std::vector<std::vector<Cell>> solution;
+	
+	// Whether the puzzle needed the scalar solver, and the nodes it visited there
+	bool searched;
+	long nodes;
+};
+
+class BatchSolver {
+	public:
+		// The most puzzles propagated together
+		static const unsigned maxLanes = 64;
+	
+	private:
+		// One bit per puzzle of the batch
+		typedef std::uint64_t Lanes;
+		
+		// The value combinations (as bitmasks) a run may take in any lane, and the lanes in which each is still feasible
+		struct RunCombos {
+			std::vector<unsigned short> masks;
+			std::vector<Lanes> alive;
+		};
+		
+		std::vector<std::vector<std::vector<Cell>>> m_boards;
+		RunIndex m_runs;
+		
+		// The lanes holding a puzzle, and the lanes propagation has proven unsolvable
+		Lanes m_active;
+		Lanes m_dead;
+		
+		// Per cell (by flat index) and value, the lanes in which the cell can still take it
+		std::vector<std::array<Lanes, 9>> m_domains;
+		
+		std::vector<RunCombos> m_combos;
+	
+	private:
+		// Constructor for a batch of at most maxLanes boards of the same shape
+		BatchSolver(const std::vector<std::vector<std::vector<Cell>>>& boards);
+		
+		// The sum a lane's puzzle gives a run (0 for no restriction)
+		int runSum(unsigned lane, const Run& run) const;
+		
+		// Narrows a run's combinations and its cells' domains in every lane at once; returns whether any domain changed
+		bool propagateRun(const Run& run, RunCombos& combos);
+		
+		// Propagates every run until nothing changes, marking lanes left with an empty domain or run as dead
+		void propagate();
+		
+		// A lane's board with every cell propagation settled filled in
+		std::vector<std::vector<Cell>> laneBoard(unsigned lane) const;
+	
+	public:
+		// A key equal for boards of the same shape
+		static std::string shapeOf(const std::vector<std::vector<Cell>>& board);
+		
+		// Solves every board, propagating boards of the same shape together and searching only where propagation falls short
+		// The options and limits apply to each search alone; boards failing checkPuzzle (see PuzzleCheck.h) are left unsolvable without being propagated
+		static std::vector<BatchResult> solve(const std::vector<std::vector<std::vector<Cell>>>& boards, const SearchOptions& options = SearchOptions(), const SolverLimits& limits = SolverLimits());
+};
+
+#endif
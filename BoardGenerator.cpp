@@ -0,0 +1,172 @@
+/**
+  * BoardGenerator.cpp
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This is an implementation of BoardGenerator.h.
+  * 		 For an explanation of the class, please consult that file.
+  */
+
+#include "BoardGenerator.h"
+#include "Cell.h"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+BoardGenerator::BoardGenerator(const GeneratorOptions& options) :
+	m_options(options), m_rng(options.seed), m_open(options.height, vector<bool>(options.width, false)), m_values(options.height, vector<int>(options.width, 0)) {
+	// No run can hold more than 9 distinct values
+	m_options.maxRun = max(1u, min(9u, m_options.maxRun));
+	m_options.minRun = max(1u, min(m_options.maxRun, m_options.minRun));
+}
+
+unsigned BoardGenerator::uniform(unsigned low, unsigned high) {
+	return uniform_int_distribution<unsigned>(low, high)(m_rng);
+}
+
+void BoardGenerator::layOut() {
+	bernoulli_distribution blank(1 - m_options.density);
+	
+	// The top row and left column stay sum cells, so every run has a sum cell to start from
+	for(unsigned i = 1; i < m_options.height; ++i) {
+		unsigned j = 1;
+		
+		while(j < m_options.width) {
+			while(j < m_options.width && blank(m_rng)) ++j;
+			
+			unsigned length = min(uniform(m_options.minRun, m_options.maxRun), m_options.width - j);
+			for(unsigned k = j; k < j + length; ++k) m_open[i][k] = true;
+			
+			// Skip the sum cell ending the run
+			j += length + 1;
+		}
+	}
+}
+
+void BoardGenerator::splitLongRuns() {
+	for(unsigned j = 1; j < m_options.width; ++j) {
+		unsigned start = 1;
+		
+		while(start < m_options.height) {
+			if(!m_open[start][j]) {
+				++start;
+				continue;
+			}
+			
+			unsigned end = start;
+			while(end < m_options.height && m_open[end][j]) ++end;
+			
+			unsigned length = end - start;
+			
+			if(length <= m_options.maxRun) {
+				start = end;
+				continue;
+			}
+			
+			// Split with both parts at least the shortest run length where that's possible, and the first part no longer than the longest
+			unsigned cut = (length >= 2 * m_options.minRun + 1) ? uniform(m_options.minRun, min(m_options.maxRun, length - m_options.minRun - 1)) : m_options.maxRun;
+			m_open[start + cut][j] = false;
+			
+			start += cut + 1;
+		}
+	}
+}
+
+bool BoardGenerator::fits(unsigned i, unsigned j, int value) const {
+	for(unsigned k = j - 1; m_open[i][k]; --k) {
+		if(m_values[i][k] == value) return false;
+	}
+	
+	for(unsigned k = i - 1; m_open[k][j]; --k) {
+		if(m_values[k][j] == value) return false;
+	}
+	
+	return true;
+}
+
+void BoardGenerator::fill() {
+	vector<pair<unsigned, unsigned>> cells;
+	
+	for(unsigned i = 0; i < m_options.height; ++i) {
+		for(unsigned j = 0; j < m_options.width; ++j) {
+			if(m_open[i][j]) cells.push_back(make_pair(i, j));
+		}
+	}
+	
+	// Fill in board order, trying each cell's values in its own random order and backing up when a cell has none left
+	vector<array<int, 9>> orders(cells.size());
+	vector<int> tried(cells.size(), 0);
+	
+	long budget = 64 * long(cells.size()) + 1000;
+	long k = 0;
+	
+	while(k >= 0 && k < long(cells.size()) && budget-- > 0) {
+		unsigned i = cells[k].first, j = cells[k].second;
+		
+		if(tried[k] == 0) {
+			for(int v = 0; v < 9; ++v) orders[k][v] = v + 1;
+			shuffle(orders[k].begin(), orders[k].end(), m_rng);
+		}
+		
+		m_values[i][j] = 0;
+		
+		while(tried[k] < 9 && !fits(i, j, orders[k][tried[k]])) ++tried[k];
+		
+		if(tried[k] < 9) {
+			m_values[i][j] = orders[k][tried[k]++];
+			++k;
+		} else {
+			tried[k] = 0;
+			--k;
+		}
+	}
+	
+	if(k == long(cells.size())) return;
+	
+	// Out of budget: v(i, j) = (i + 2j) mod 9 never repeats within 9 cells of a row or column, and runs are never longer than that
+	array<int, 9> digits{{1, 2, 3, 4, 5, 6, 7, 8, 9}};
+	shuffle(digits.begin(), digits.end(), m_rng);
+	
+	for(const pair<unsigned, unsigned>& cell : cells) {
+		m_values[cell.first][cell.second] = digits[(cell.first + 2 * cell.second) % 9];
+	}
+}
+
+vector<vector<Cell>> BoardGenerator::generate() {
+	vector<vector<Cell>> board;
+	if(m_options.height < 2 || m_options.width < 2) return board;
+	
+	layOut();
+	splitLongRuns();
+	fill();
+	
+	bernoulli_distribution given(m_options.givens);
+	
+	for(unsigned i = 0; i < m_options.height; ++i) {
+		vector<Cell> row;
+		
+		for(unsigned j = 0; j < m_options.width; ++j) {
+			if(m_open[i][j]) {
+				row.push_back(given(m_rng) ? Cell(m_values[i][j], true) : Cell(0, false));
+				continue;
+			}
+			
+			// A sum cell's sums are those of the fill's runs to its right and below it (0 where there's no run)
+			int right(0), down(0);
+			for(unsigned k = j + 1; k < m_options.width && m_open[i][k]; ++k) right += m_values[i][k];
+			for(unsigned k = i + 1; k < m_options.height && m_open[k][j]; ++k) down += m_values[k][j];
+			
+			row.push_back(Cell(down, right));
+		}
+		
+		board.push_back(row);
+	}
+	
+	return board;
+}
@@ -0,0 +1,71 @@
+/**
+  * BoardGenerator.h
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This class makes random puzzles of any size for stress tests and benchmarks.
+  *		 It lays out runs row by row, splits any column run that's too long, fills every value cell so no run repeats a value, and derives the sums from the fill.
+  *		 Every puzzle it makes has a solution (the fill), but not necessarily only one.
+  *		 The same options and seed always make the same puzzle.
+  */
+
+#ifndef KGENERATOR_H
+#define KGENERATOR_H
+
+#include "Cell.h"
+
+#include <random>
+#include <vector>
+
+struct GeneratorOptions {
+	unsigned height, width;
+	
+	// How tightly runs are packed: past the sum cell that ends a run, each cell is another sum cell with probability 1 - density
+	double density;
+	
+	// The lengths runs are laid out with; column runs longer than maxRun are split (which can leave shorter runs than minRun)
+	unsigned minRun, maxRun;
+	
+	// The share of value cells given filled in
+	double givens;
+	
+	unsigned seed;
+	
+	GeneratorOptions() : height(20), width(20), density(0.8), minRun(2), maxRun(5), givens(0.3), seed(1) {}
+};
+
+class BoardGenerator {
+	private:
+		GeneratorOptions m_options;
+		std::mt19937 m_rng;
+		
+		// Which cells are value cells, and the value each one gets
+		std::vector<std::vector<bool>> m_open;
+		std::vector<std::vector<int>> m_values;
+	
+	private:
+		// A random number from low to high, inclusive
+		unsigned uniform(unsigned low, unsigned high);
+		
+		// Lays out the runs of each row
+		void layOut();
+		
+		// Splits column runs longer than the longest allowed, with a sum cell inside them
+		void splitLongRuns();
+		
+		// Whether a value is still free in both runs of a cell, going by the cells filled before it
+		bool fits(unsigned i, unsigned j, int value) const;
+		
+		// Fills every value cell so no run repeats a value, searching with a budget and falling back on a fill that can't fail
+		void fill();
+	
+	public:
+		BoardGenerator(const GeneratorOptions& options);
+	
+	public:
+		// Makes the puzzle: sum cells with the fill's sums, and value cells (empty unless given)
+		std::vector<std::vector<Cell>> generate();
+};
+
+#endif
@@ -0,0 +1,225 @@
+/**
+  * BoardView.cpp
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This is an implementation of BoardView.h.
+  * 		 For an explanation of the class, please consult that file.
+  */
+
+#include "BoardView.h"
+#include "Cell.h"
+
+#include <QColor>
+#include <QFont>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QRect>
+#include <QSize>
+#include <QSizePolicy>
+#include <QString>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+BoardView::BoardView(QWidget* parent) : QWidget(parent), m_board(), m_selectedRow(-1), m_selectedCol(-1), m_conflicts() {
+	setFocusPolicy(Qt::StrongFocus);
+	setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+}
+
+int BoardView::numRows() const {
+	return m_board.size();
+}
+
+int BoardView::numCols() const {
+	return m_board.empty() ? 0 : m_board.at(0).size();
+}
+
+QRect BoardView::cellRect(int row, int col) const {
+	return QRect(col * cellSize, row * cellSize, cellSize, cellSize);
+}
+
+bool BoardView::isEditable(int row, int col) const {
+	if(row < 0 || col < 0 || row >= numRows() || col >= numCols()) return false;
+	
+	const Cell& cell = m_board.at(row).at(col);
+	return cell.isValueCell() && !cell.isFixed();
+}
+
+void BoardView::select(int row, int col) {
+	if(m_selectedRow >= 0) update(cellRect(m_selectedRow, m_selectedCol));
+	
+	m_selectedRow = row;
+	m_selectedCol = col;
+	
+	if(m_selectedRow >= 0) update(cellRect(m_selectedRow, m_selectedCol));
+}
+
+void BoardView::editSelected(int value) {
+	if(!isEditable(m_selectedRow, m_selectedCol)) return;
+	
+	Cell& cell = m_board.at(m_selectedRow).at(m_selectedCol);
+	if(cell.value() == value) return;
+	
+	cell.setValue(value);
+	m_conflicts.at(m_selectedRow).at(m_selectedCol) = false;
+	update(cellRect(m_selectedRow, m_selectedCol));
+	
+	emit cellEdited(m_selectedRow, m_selectedCol, value);
+}
+
+bool BoardView::setBoard(const vector<vector<Cell>>& board) {
+	bool resized = board.size() != m_board.size() || (!board.empty() && board.at(0).size() != m_board.at(0).size());
+	
+	if(resized) {
+		m_board = board;
+		m_selectedRow = m_selectedCol = -1;
+		m_conflicts.assign(numRows(), vector<bool>(numCols(), false));
+		
+		updateGeometry();
+		update();
+		
+		return true;
+	}
+	
+	// Same shape: only touch the cells that changed
+	for(int i = 0; i < numRows(); ++i) {
+		for(int j = 0; j < numCols(); ++j) {
+			const Cell& cell = board.at(i).at(j);
+			
+			if(!(cell == m_board.at(i).at(j)) || cell.isFixed() != m_board.at(i).at(j).isFixed()) {
+				m_board.at(i).at(j) = cell;
+				m_conflicts.at(i).at(j) = false;
+				update(cellRect(i, j));
+			}
+		}
+	}
+	
+	return false;
+}
+
+const vector<vector<Cell>>& BoardView::board() const {
+	return m_board;
+}
+
+void BoardView::setConflicts(const vector<pair<int, int>>& cells) {
+	for(int i = 0; i < numRows(); ++i) {
+		for(int j = 0; j < numCols(); ++j) {
+			if(m_conflicts.at(i).at(j)) {
+				m_conflicts.at(i).at(j) = false;
+				update(cellRect(i, j));
+			}
+		}
+	}
+	
+	for(const pair<int, int>& cell : cells) {
+		if(cell.first < 0 || cell.second < 0 || cell.first >= numRows() || cell.second >= numCols()) continue;
+		
+		m_conflicts.at(cell.first).at(cell.second) = true;
+		update(cellRect(cell.first, cell.second));
+	}
+}
+
+QSize BoardView::sizeHint() const {
+	return QSize(numCols() * cellSize + 1, numRows() * cellSize + 1);
+}
+
+QSize BoardView::minimumSizeHint() const {
+	return sizeHint();
+}
+
+void BoardView::paintEvent(QPaintEvent* event) {
+	QPainter painter(this);
+	
+	QFont valueFont = painter.font();
+	valueFont.setPixelSize(cellSize / 2);
+	
+	QFont sumFont = painter.font();
+	sumFont.setPixelSize(cellSize / 4 + 1);
+	
+	// Only the cells in the damaged area need painting
+	QRect area = event->rect();
+	int firstRow = max(0, area.top() / cellSize), lastRow = min(numRows() - 1, area.bottom() / cellSize);
+	int firstCol = max(0, area.left() / cellSize), lastCol = min(numCols() - 1, area.right() / cellSize);
+	
+	for(int i = firstRow; i <= lastRow; ++i) {
+		for(int j = firstCol; j <= lastCol; ++j) {
+			const Cell& cell = m_board.at(i).at(j);
+			QRect rect = cellRect(i, j);
+			
+			if(cell.isValueCell()) {
+				bool selected = (i == m_selectedRow && j == m_selectedCol);
+				QColor background = selected ? QColor(255, 240, 170) : Qt::white;
+				if(m_conflicts.at(i).at(j)) background = selected ? QColor(255, 170, 120) : QColor(255, 190, 190);
+				
+				painter.fillRect(rect, background);
+				
+				if(cell.value() > 0) {
+					painter.setFont(valueFont);
+					painter.setPen(cell.isFixed() ? Qt::black : QColor(30, 80, 200));
+					painter.drawText(rect, Qt::AlignCenter, QString::number(cell.value()));
+				}
+			} else {
+				painter.fillRect(rect, Qt::darkGray);
+				
+				// Sum cells are split by a diagonal, with the down sum below it and the right sum above it
+				if(cell.downSum() != 0 || cell.rightSum() != 0) {
+					painter.setPen(Qt::lightGray);
+					painter.drawLine(rect.topLeft(), rect.bottomRight());
+					
+					painter.setFont(sumFont);
+					painter.setPen(Qt::white);
+					
+					QRect inner = rect.adjusted(2, 1, -2, -1);
+					if(cell.downSum() != 0) painter.drawText(inner, Qt::AlignLeft | Qt::AlignBottom, QString::number(cell.downSum()));
+					if(cell.rightSum() != 0) painter.drawText(inner, Qt::AlignRight | Qt::AlignTop, QString::number(cell.rightSum()));
+				}
+			}
+			
+			painter.setPen(Qt::black);
+			painter.drawRect(rect);
+		}
+	}
+}
+
+void BoardView::mousePressEvent(QMouseEvent* event) {
+	int row = event->pos().y() / cellSize;
+	int col = event->pos().x() / cellSize;
+	
+	if(isEditable(row, col)) {
+		select(row, col);
+	} else {
+		select(-1, -1);
+	}
+}
+
+void BoardView::keyPressEvent(QKeyEvent* event) {
+	int key = event->key();
+	
+	if(key >= Qt::Key_1 && key <= Qt::Key_9) {
+		editSelected(key - Qt::Key_0);
+	} else if(key == Qt::Key_0 || key == Qt::Key_Minus || key == Qt::Key_Backspace || key == Qt::Key_Delete) {
+		editSelected(0);
+	} else if(key == Qt::Key_Up || key == Qt::Key_Down || key == Qt::Key_Left || key == Qt::Key_Right) {
+		if(m_selectedRow < 0) return;
+		
+		// Skip over anything that can't be edited in the direction of the arrow
+		int dRow = (key == Qt::Key_Up) ? -1 : (key == Qt::Key_Down) ? 1 : 0;
+		int dCol = (key == Qt::Key_Left) ? -1 : (key == Qt::Key_Right) ? 1 : 0;
+		
+		for(int i = m_selectedRow + dRow, j = m_selectedCol + dCol; i >= 0 && j >= 0 && i < numRows() && j < numCols(); i += dRow, j += dCol) {
+			if(isEditable(i, j)) {
+				select(i, j);
+				break;
+			}
+		}
+	} else {
+		QWidget::keyPressEvent(event);
+	}
+}
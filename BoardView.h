@@ -0,0 +1,88 @@
+/**
+  * BoardView.h
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This widget draws the Kakuro board and lets the player fill in value cells.
+  *		 The whole board is painted by the one widget, so showing a new config costs no widget construction.
+  *		 Only the cells whose contents changed are repainted.
+  *		 A value cell is selected by clicking it (or with the arrow keys) and filled by typing a digit; 0, '-', Backspace and Delete clear it.
+  *		 Cells can be highlighted as conflicting, e.g. the player's entries no solution agrees with.
+  */
+
+#ifndef BOARDVIEW_H
+#define BOARDVIEW_H
+
+#include "Cell.h"
+
+#include <QRect>
+#include <QSize>
+#include <QWidget>
+
+#include <utility>
+#include <vector>
+
+class QKeyEvent;
+class QMouseEvent;
+class QPaintEvent;
+
+class BoardView : public QWidget {
+	Q_OBJECT
+	
+	private:
+		// The side of a cell in pixels
+		static const int cellSize = 32;
+		
+		// The board as currently drawn
+		std::vector<std::vector<Cell>> m_board;
+		
+		// The selected cell, or -1 if none is
+		int m_selectedRow, m_selectedCol;
+		
+		// Cells marked as conflicting (see setConflicts), the same shape as the board
+		std::vector<std::vector<bool>> m_conflicts;
+	
+	private:
+		int numRows() const;
+		int numCols() const;
+		
+		// The area a cell is drawn in
+		QRect cellRect(int row, int col) const;
+		
+		// Whether a cell can be filled in by the player
+		bool isEditable(int row, int col) const;
+		
+		// Moves the selection to a cell, repainting the old and new selections
+		void select(int row, int col);
+		
+		// Fills (or clears, with 0) the selected cell and tells whoever is listening
+		void editSelected(int value);
+	
+	protected:
+		void paintEvent(QPaintEvent* event);
+		void mousePressEvent(QMouseEvent* event);
+		void keyPressEvent(QKeyEvent* event);
+	
+	signals:
+		// Emitted when the player changes a cell (value 0 means the cell was cleared)
+		void cellEdited(int row, int col, int value);
+	
+	public:
+		BoardView(QWidget* parent = 0);
+		
+		// Shows a board, repainting only the cells that differ from the board shown before
+		// Returns true if the board's dimensions changed, in which case everything is repainted
+		bool setBoard(const std::vector<std::vector<Cell>>& board);
+		
+		// The board as currently shown, including the player's edits
+		const std::vector<std::vector<Cell>>& board() const;
+		
+		// Highlights cells (as row, column pairs) in place of any highlighted before; a highlight goes once its cell changes
+		void setConflicts(const std::vector<std::pair<int, int>>& cells);
+		
+		QSize sizeHint() const;
+		QSize minimumSizeHint() const;
+};
+
+#endif
@@ -20,6 +20,8 @@ Cell::Cell(int value, bool isFixed = false) :
 Cell::Cell(int downSum, int rightSum) : 
 	m_isValueCell(false), m_value(-1), m_numPossibleValues(-1), m_isFixed(false), m_rightSum(rightSum), m_downSum(downSum) {}
 
+Cell::Cell() : Cell(0, 0) {}
+
 bool Cell::isValueCell() const {
 	return m_isValueCell;
 }
@@ -33,20 +35,8 @@ bool Cell::isFixed() const {
 	return m_isFixed;
 }
 
-int Cell::numPossibleValues() {
-	if(false || m_numPossibleValues != -1) {
-		return m_numPossibleValues;
-	} else {
-		int num = 0;
-		for(bool b : m_possibleValues) {
-			if(b) ++num;
-		}
-		
-		// Cache the result
-		m_numPossibleValues = num;
-		
-		return num;
-	}
+int Cell::numPossibleValues() const {
+	return m_numPossibleValues;
 }
 
 array<bool, 9> Cell::possibleValues() const {
@@ -60,8 +50,11 @@ void Cell::setValue(int value) {
 void Cell::setPossibleValues(array<bool, 9> possibleValues) {
 	m_possibleValues = possibleValues;
 	
-	// Invalidate our numPossibleValues cache
-	m_numPossibleValues = -1;
+	// Count them now, so reading the count never writes to a cell another board may share
+	m_numPossibleValues = 0;
+	for(bool b : m_possibleValues) {
+		if(b) ++m_numPossibleValues;
+	}
 }
 
 // For sum cells
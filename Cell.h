@@ -37,6 +37,9 @@ class Cell {
 		// Constructor for sum cells
 		// 0 values mean no restriction
 		Cell(int downSum, int rightSum);
+		
+		// Constructor for an unrestricted sum cell, so cells can fill fixed-size arrays before the real ones are copied in
+		Cell();
 	
 	public:
 		bool isValueCell() const;
@@ -50,7 +53,7 @@ class Cell {
 		bool isFixed() const;
 		
 		// The number of possible values for the cell
-		int numPossibleValues();
+		int numPossibleValues() const;
 		
 		// The possible values for the cell
 		std::array<bool, 9> possibleValues() const;
@@ -0,0 +1,305 @@
+/**
+  * Checkpoint.cpp
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This is an implementation of Checkpoint.h.
+  * 		 For an explanation of the class, please consult that file.
+  */
+
+#include "Cell.h"
+#include "Checkpoint.h"
+#include "SearchContext.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// The file starts with a magic number and a format version; everything after is little-endian, with values and sums in one byte each
+static const char checkpointMagic[4] = {'K', 'C', 'K', 'P'};
+static const uint32_t checkpointVersion = 1;
+
+// Appends fixed-width fields to a buffer
+class CheckpointWriter {
+	private:
+		vector<unsigned char> m_bytes;
+	
+	public:
+		void put8(unsigned value) {
+			m_bytes.push_back(value & 0xFF);
+		}
+		
+		void put32(uint32_t value) {
+			for(int k = 0; k < 4; ++k) put8(value >> (8 * k));
+		}
+		
+		void put64(uint64_t value) {
+			for(int k = 0; k < 8; ++k) put8(value >> (8 * k));
+		}
+		
+		void putDouble(double value) {
+			uint64_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			put64(bits);
+		}
+		
+		const vector<unsigned char>& bytes() const {
+			return m_bytes;
+		}
+};
+
+// Reads fixed-width fields back, failing (and reading zeros) once the buffer runs out
+class CheckpointReader {
+	private:
+		const vector<unsigned char>& m_bytes;
+		size_t m_pos;
+		bool m_ok;
+	
+	public:
+		CheckpointReader(const vector<unsigned char>& bytes) : m_bytes(bytes), m_pos(0), m_ok(true) {}
+	
+	public:
+		unsigned get8() {
+			if(m_pos >= m_bytes.size()) {
+				m_ok = false;
+				return 0;
+			}
+			
+			return m_bytes[m_pos++];
+		}
+		
+		uint32_t get32() {
+			uint32_t value(0);
+			for(int k = 0; k < 4; ++k) value |= uint32_t(get8()) << (8 * k);
+			
+			return value;
+		}
+		
+		uint64_t get64() {
+			uint64_t value(0);
+			for(int k = 0; k < 8; ++k) value |= uint64_t(get8()) << (8 * k);
+			
+			return value;
+		}
+		
+		double getDouble() {
+			uint64_t bits = get64();
+			double value;
+			memcpy(&value, &bits, sizeof(value));
+			
+			return value;
+		}
+		
+		// Whether every read so far found its bytes, and whether the buffer has been read to its end
+		bool ok() const {
+			return m_ok;
+		}
+		
+		bool done() const {
+			return m_pos == m_bytes.size();
+		}
+};
+
+bool Checkpoint::matches(const vector<vector<Cell>>& other, const SearchOptions& otherOptions) const {
+	if(other.size() != board.size()) return false;
+	
+	for(unsigned i = 0; i < board.size(); ++i) {
+		if(other[i].size() != board[i].size()) return false;
+		
+		for(unsigned j = 0; j < board[i].size(); ++j) {
+			const Cell& a = board[i][j];
+			const Cell& b = other[i][j];
+			
+			if(a.isValueCell() != b.isValueCell()) return false;
+			
+			if(a.isValueCell() ? (a.value() != b.value() || a.isFixed() != b.isFixed()) : (a.downSum() != b.downSum() || a.rightSum() != b.rightSum())) return false;
+		}
+	}
+	
+	return options.cellOrdering == otherOptions.cellOrdering && options.valueOrdering == otherOptions.valueOrdering && options.propagateBounds == otherOptions.propagateBounds &&
+		options.propagateCombinations == otherOptions.propagateCombinations && options.decompose == otherOptions.decompose && options.randomTies == otherOptions.randomTies &&
+		options.seed == otherOptions.seed;
+}
+
+bool Checkpoint::write(const string& filename) const {
+	CheckpointWriter out;
+	
+	for(char c : checkpointMagic) out.put8(c);
+	out.put32(checkpointVersion);
+	
+	out.put32(board.size());
+	out.put32(board.empty() ? 0 : board[0].size());
+	
+	for(const vector<Cell>& row : board) {
+		for(const Cell& c : row) {
+			out.put8(c.isValueCell());
+			out.put8(c.isValueCell() ? c.value() : c.downSum());
+			out.put8(c.isValueCell() ? c.isFixed() : c.rightSum());
+		}
+	}
+	
+	out.put8(unsigned(options.cellOrdering));
+	out.put8(unsigned(options.valueOrdering));
+	out.put8(options.propagateBounds);
+	out.put8(options.propagateCombinations);
+	out.put8(options.decompose);
+	out.put8(options.randomTies);
+	out.put32(options.seed);
+	
+	out.put64(nodes);
+	out.put32(attempt);
+	out.put64(attemptStart);
+	out.put32(restarts);
+	out.putDouble(covered);
+	out.putDouble(weighted);
+	
+	out.put32(runWeights.size());
+	for(unsigned weight : runWeights) out.put32(weight);
+	
+	out.put32(frames.size());
+	
+	for(const CheckpointFrame& frame : frames) {
+		out.put8(frame.split);
+		
+		if(frame.split) {
+			out.put32(frame.parts);
+			out.put32(frame.finished.size());
+			
+			for(const vector<array<int, 3>>& part : frame.finished) {
+				out.put32(part.size());
+				
+				for(const array<int, 3>& cell : part) {
+					out.put32(cell[0]);
+					out.put32(cell[1]);
+					out.put8(cell[2]);
+				}
+			}
+		} else {
+			out.put32(frame.cell);
+			out.put8(frame.branches);
+			out.put8(frame.value);
+			out.put8(frame.remaining.size());
+			for(int value : frame.remaining) out.put8(value);
+			out.put64(frame.rngState);
+		}
+	}
+	
+	// Written beside the old checkpoint and moved over it, so there's always a whole one to resume from
+	string temporary = filename + ".tmp";
+	
+	{
+		ofstream file(temporary, ios::binary | ios::trunc);
+		file.write(reinterpret_cast<const char*>(out.bytes().data()), out.bytes().size());
+		file.flush();
+		
+		if(!file) return false;
+	}
+	
+	return rename(temporary.c_str(), filename.c_str()) == 0;
+}
+
+bool Checkpoint::read(const string& filename) {
+	ifstream file(filename, ios::binary);
+	if(!file) return false;
+	
+	vector<unsigned char> bytes((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+	CheckpointReader in(bytes);
+	
+	for(char c : checkpointMagic) {
+		if(in.get8() != static_cast<unsigned char>(c)) return false;
+	}
+	
+	if(in.get32() != checkpointVersion) return false;
+	
+	// Read into a copy, so a bad file leaves this one untouched
+	Checkpoint read;
+	
+	unsigned height = in.get32(), width = in.get32();
+	if(uint64_t(height) * width * 3 > bytes.size()) return false;
+	
+	for(unsigned i = 0; i < height; ++i) {
+		vector<Cell> row;
+		
+		for(unsigned j = 0; j < width; ++j) {
+			bool isValueCell = in.get8();
+			int a = in.get8(), b = in.get8();
+			
+			row.push_back(isValueCell ? Cell(a, b != 0) : Cell(a, b));
+		}
+		
+		read.board.push_back(row);
+	}
+	
+	read.options.cellOrdering = CellOrdering(in.get8());
+	read.options.valueOrdering = ValueOrdering(in.get8());
+	read.options.propagateBounds = in.get8();
+	read.options.propagateCombinations = in.get8();
+	read.options.decompose = in.get8();
+	read.options.randomTies = in.get8();
+	read.options.seed = in.get32();
+	
+	read.nodes = in.get64();
+	read.attempt = in.get32();
+	read.attemptStart = in.get64();
+	read.restarts = in.get32();
+	read.covered = in.getDouble();
+	read.weighted = in.getDouble();
+	
+	unsigned numWeights = in.get32();
+	if(numWeights > bytes.size()) return false;
+	
+	for(unsigned k = 0; k < numWeights; ++k) read.runWeights.push_back(in.get32());
+	
+	unsigned numFrames = in.get32();
+	if(numFrames > bytes.size()) return false;
+	
+	for(unsigned k = 0; k < numFrames && in.ok(); ++k) {
+		CheckpointFrame frame;
+		frame.split = in.get8();
+		
+		if(frame.split) {
+			frame.parts = in.get32();
+			
+			unsigned numFinished = in.get32();
+			if(numFinished > frame.parts) return false;
+			
+			for(unsigned p = 0; p < numFinished && in.ok(); ++p) {
+				unsigned numCells = in.get32();
+				if(numCells > bytes.size()) return false;
+				
+				vector<array<int, 3>> cells;
+				
+				for(unsigned c = 0; c < numCells; ++c) {
+					int row = in.get32(), col = in.get32(), value = in.get8();
+					cells.push_back(array<int, 3>{{row, col, value}});
+				}
+				
+				frame.finished.push_back(cells);
+			}
+		} else {
+			frame.cell = in.get32();
+			frame.branches = in.get8();
+			frame.value = in.get8();
+			
+			unsigned numRemaining = in.get8();
+			for(unsigned r = 0; r < numRemaining; ++r) frame.remaining.push_back(in.get8());
+			
+			frame.rngState = in.get64();
+		}
+		
+		read.frames.push_back(frame);
+	}
+	
+	if(!in.ok() || !in.done()) return false;
+	
+	*this = read;
+	return true;
+}
@@ -0,0 +1,77 @@
+/**
+  * Checkpoint.h
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This is a snapshot of a search in progress, from which Solver can pick the search up again.
+  *		 It holds the path from the root to the node being searched (per level, the value being explored and the sibling values not yet tried) and the counters and learned state needed to carry on exactly as before.
+  *		 Everything left of the path has been searched, so resuming replays the path and searches what's right of it, giving the same result an uninterrupted run would have.
+  *		 Levels where the config was split into parts record the cells each finished part filled, and are followed by the levels of the part being solved.
+  *		 Checkpoints are written to a new file that then replaces the old one, so a crash mid-write leaves the previous checkpoint intact.
+  */
+
+#ifndef KCHECKPOINT_H
+#define KCHECKPOINT_H
+
+#include "Cell.h"
+#include "SearchContext.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One level of the path being searched
+struct CheckpointFrame {
+	// Whether the config on this level was split into parts rather than branched on
+	bool split;
+	
+	// A branch: the cell (flat index) branched on, the number of values it had, the value being explored, the values left to try after it, and the random state its children start with
+	int cell;
+	unsigned branches;
+	int value;
+	std::vector<int> remaining;
+	std::uint64_t rngState;
+	
+	// A split: the number of parts, and the cells (row, column, value) each finished part filled; the part being solved is the one after them
+	unsigned parts;
+	std::vector<std::vector<std::array<int, 3>>> finished;
+	
+	CheckpointFrame() : split(false), cell(-1), branches(0), value(0), remaining(), rngState(0), parts(0), finished() {}
+};
+
+struct Checkpoint {
+	// The board and search options the search started from; a checkpoint can only resume the same search
+	std::vector<std::vector<Cell>> board;
+	SearchOptions options;
+	
+	// The nodes visited so far, the restart attempt under way and the node count it began at, and the attempts abandoned before it
+	long nodes;
+	unsigned attempt;
+	long attemptStart;
+	int restarts;
+	
+	// The progress estimator's totals for the attempt (see SolveProgress)
+	double covered;
+	double weighted;
+	
+	// The failure weights the search has learned per run
+	std::vector<unsigned> runWeights;
+	
+	// The path from the root to the node being searched, one frame per level
+	std::vector<CheckpointFrame> frames;
+	
+	Checkpoint() : board(), options(), nodes(0), attempt(0), attemptStart(0), restarts(0), covered(0), weighted(0), runWeights(), frames() {}
+	
+	// Whether the checkpoint was taken of a search of this board with these options
+	bool matches(const std::vector<std::vector<Cell>>& board, const SearchOptions& options) const;
+	
+	// Writes the checkpoint to a file, replacing it only once the new one is complete; returns false if it couldn't be written
+	bool write(const std::string& filename) const;
+	
+	// Reads a checkpoint written by write; returns false (leaving the checkpoint as it was) if the file is missing or isn't one
+	bool read(const std::string& filename);
+};
+
+#endif
@@ -0,0 +1,77 @@
+/**
+  * FixedBoard.h
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This class is a board of cells whose dimensions are fixed at compile time, stored in one array.
+  *		 It has the same interface as TiledBoard, so a config can be built on either.
+  *		 The dimensions are constants, so loops over the board have known bounds and a config's board lives inside the config rather than on the heap.
+  */
+
+#ifndef KFIXED_H
+#define KFIXED_H
+
+#include "Cell.h"
+
+#include <array>
+#include <vector>
+
+template <unsigned Height, unsigned Width>
+class FixedBoard {
+	private:
+		std::array<Cell, Height * Width> m_cells;
+		
+		// Whether the board holds a puzzle (boards read from unusable input are empty)
+		bool m_empty;
+	
+	public:
+		// Constructor for an empty board
+		FixedBoard() : m_cells(), m_empty(true) {}
+		
+		// Constructor for a board holding the given cells, which must be Height by Width (or none at all)
+		explicit FixedBoard(const std::vector<std::vector<Cell>>& board) : m_cells(), m_empty(board.empty()) {
+			if(m_empty) return;
+			
+			for(unsigned i = 0; i < Height; ++i) {
+				for(unsigned j = 0; j < Width; ++j) m_cells[i * Width + j] = board[i][j];
+			}
+		}
+	
+	public:
+		static constexpr unsigned height() {
+			return Height;
+		}
+		
+		static constexpr unsigned width() {
+			return Width;
+		}
+		
+		bool empty() const {
+			return m_empty;
+		}
+		
+		// The cell at a position
+		const Cell& at(unsigned row, unsigned col) const {
+			return m_cells[row * Width + col];
+		}
+		
+		// The cell at a position, to be changed
+		Cell& edit(unsigned row, unsigned col) {
+			return m_cells[row * Width + col];
+		}
+		
+		// The cells as rows
+		std::vector<std::vector<Cell>> toRows() const {
+			std::vector<std::vector<Cell>> rows;
+			if(m_empty) return rows;
+			
+			for(unsigned i = 0; i < Height; ++i) {
+				rows.push_back(std::vector<Cell>(m_cells.begin() + i * Width, m_cells.begin() + (i + 1) * Width));
+			}
+			
+			return rows;
+		}
+};
+
+#endif
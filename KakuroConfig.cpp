@@ -11,141 +11,143 @@
 #include "Cell.h"
 #include "KakuroConfig.h"
 #include "Partitioner.h"
+#include "RunIndex.h"
+#include "SearchContext.h"
+#include "Solver.h"
+#include "SolverStats.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace std;
 
-array<bool, 9> availableValues(const vector<vector<Cell>>& board, int ver, int hor, bool vertical) {
-	unsigned ptr(vertical ? ver : hor);
+template <class Board>
+bool BasicKakuroConfig<Board>::isSolution(const vector<vector<Cell>>& board) {
+	if(board.empty()) return false;
 	
-	while(board.at(vertical ? --ptr : ver).at(vertical ? hor : --ptr).isValueCell());
+	unsigned width = board[0].size();
 	
-	int sum = (vertical ? board.at(ptr).at(hor).downSum() : board.at(ver).at(ptr).rightSum());
+	// One sweep over the rows; the horizontal run is tracked for the current row and the vertical runs for every column
+	// A run's remaining sum only matters if its sum cell restricts it
+	vector<int> colRemaining(width, 0);
+	vector<bool> colRestricted(width, false);
+	vector<unsigned> colUsed(width, 0);
 	
-	int avail(0);
-	int totalUsed(0);
-	int numNeighbors(0);
-	array<bool, 9> used{};
-	
-	auto bound = vertical ? board.size() : board.at(0).size();
-	while(ptr+1 < bound) {
-		const Cell& c = board[vertical ? ++ptr : ver][vertical ? hor : ++ptr];
-		if(!c.isValueCell()) break;
-		++numNeighbors;
-		if(c.value() > 0) {
-			totalUsed += c.value();
-			used[c.value() - 1] = true;
-		} else if(c.value() == 0) {
-			++avail;
-		} else {
-			cout << c << endl;
-		}
-	}
-	
-	return Partitioner::getInstance().possibleValues(sum - totalUsed, avail, used);
-}
-
-bool KakuroConfig::slowIsGoal() const {
-	for(unsigned i = 0; i < m_board.size(); ++i) {
-		for(unsigned j = 0; j < m_board.at(0).size(); ++j) {
-			const Cell& c = m_board.at(i).at(j);
+	for(unsigned i = 0; i < board.size(); ++i) {
+		int rowRemaining(0);
+		bool rowRestricted(false);
+		unsigned rowUsed(0);
+		
+		for(unsigned j = 0; j <= width; ++j) {
+			// A sum cell (or the end of the row) closes the horizontal run before it
+			if(j == width || !board[i][j].isValueCell()) {
+				if(rowRestricted && rowRemaining != 0) return false;
+				
+				if(j == width) break;
+			}
 			
-			if(!c.isValueCell()) {
-				if(c.downSum() > 0) {
-					unsigned verPtr(i);
-					int sum(0);
-					array<bool, 9> used{};
-					
-					while(verPtr+1 < m_board.size()) {
-						const Cell& vc = m_board.at(++verPtr).at(j);
-						
-						if(!vc.isValueCell()) break;
-						
-						int val = vc.value();
-						
-						if(val == 0) return false;
-						
-						sum += val;
-						
-						if(used[val - 1]) return false;
-						
-						used[val - 1] = true;
-					}
-					
-					if(sum != c.downSum()) return false;
-				}
+			const Cell& c = board[i][j];
+			
+			if(c.isValueCell()) {
+				int val = c.value();
+				if(val < 1 || val > 9) return false;
 				
-				if(c.rightSum() > 0) {
-					unsigned horPtr(j);
-					int sum(0);
-					array<bool, 9> used{};
-					
-					while(horPtr+1 < m_board.at(0).size()) {
-						const Cell& vc = m_board.at(i).at(++horPtr);
-						
-						if(!vc.isValueCell()) break;
-						
-						int val = vc.value();
-						
-						if(val == 0) return false;
-						
-						sum += val;
-						
-						if(used[val - 1]) return false;
-						
-						used[val - 1] = true;
-					}
-					
-					if(sum != c.rightSum()) return false;
-				}
+				unsigned bit = 1 << (val - 1);
+				if((rowUsed & bit) || (colUsed[j] & bit)) return false;
+				
+				rowUsed |= bit;
+				colUsed[j] |= bit;
+				rowRemaining -= val;
+				colRemaining[j] -= val;
+			} else {
+				// ...and the vertical run above it, then both of its own runs start
+				if(colRestricted[j] && colRemaining[j] != 0) return false;
+				
+				rowRemaining = c.rightSum();
+				rowRestricted = c.rightSum() > 0;
+				rowUsed = 0;
+				
+				colRemaining[j] = c.downSum();
+				colRestricted[j] = c.downSum() > 0;
+				colUsed[j] = 0;
 			}
 		}
 	}
 	
+	// The bottom row closes every vertical run still open
+	for(unsigned j = 0; j < width; ++j) {
+		if(colRestricted[j] && colRemaining[j] != 0) return false;
+	}
+	
 	return true;
 }
 
-KakuroConfig::KakuroConfig(vector<vector<Cell>> board, bool shouldDelta) : 
-	m_deltaI(0), m_deltaJ(0), m_isGoal(false), m_shouldDelta(shouldDelta), m_board(board), m_parent(nullptr) {
-	// If our root config is the goal, don't do any more work
-	if(slowIsGoal()) {
-		m_isGoal = true;
-		return;
-	}
+template <class Board>
+BasicKakuroConfig<Board>::BasicKakuroConfig(vector<vector<Cell>> board, bool shouldDelta) : 
+	m_deltaI(0), m_deltaJ(0), m_shouldDelta(shouldDelta), m_deltaValue(0), m_board(board), 
+	m_runs(make_shared<RunIndex>(board)), m_context(make_shared<SearchContext>(SearchOptions(), m_runs->runs().size())), 
+	m_runStates(m_runs->runs().size(), RunState()), m_unfilled(0), m_violations(0), m_contradiction(false), m_stale(false), 
+	m_buckets(), m_bucketPos(m_runs->height() * m_runs->width(), -1), m_rngState(0), m_parent(nullptr) {
+	reseed(0);
 	
-	// Compute initial possible values for all cells
-	
-	// The possible values for a cell are 
-	// the intersection of the integer partition sets 
-	// of each dimensional neighbor group with target sums 
-	// determined by the sum cells
-	for(unsigned i = 0; i < m_board.size(); ++i) {
-		for(unsigned j = 0; j < m_board.size(); ++j) {
-			Cell& cursor = m_board[i][j];
+	// Tally what every run already holds
+	for(unsigned run = 0; run < m_runs->runs().size(); ++run) {
+		RunState& state = m_runStates.edit(run);
+		
+		state.remaining = m_runs->runs()[run].sum;
+		state.unfilled = 0;
+		state.counts = array<unsigned char, 9>();
+		state.duplicates = 0;
+		
+		for(unsigned index : m_runs->runs()[run].cells) {
+			int val = cellAt(index).value();
 			
-			if(cursor.isValueCell()) {
-				// Do two walks, horizontally and vertically
-				// Count the number of peers and establish target sums
-				// Then intersect possible values
-				
-				array<bool, 9> horPossibles = availableValues(m_board, i, j, false);
-				array<bool, 9> verPossibles = availableValues(m_board, i, j, false);
-				
-				array<bool, 9> cellPossibles = Partitioner::getInstance().intersection(horPossibles, verPossibles);
-				
-				cursor.setPossibleValues(cellPossibles);
+			// A value that isn't a digit (readBoard takes any integer) breaks its run rather than being tallied
+			if(val < 0 || val > 9) {
+				++state.duplicates;
+			} else if(val > 0) {
+				state.remaining -= val;
+				if(state.counts[val - 1]++ > 0) ++state.duplicates;
+			} else {
+				++state.unfilled;
 			}
 		}
+		
+		if(runViolated(run)) ++m_violations;
 	}
+	
+	for(unsigned i = 0; i < m_board.height(); ++i) {
+		for(unsigned j = 0; j < m_board.width(); ++j) {
+			const Cell& c = m_board.at(i, j);
+			if(c.isValueCell() && c.value() == 0) ++m_unfilled;
+		}
+	}
+	
+	// If our root config is the goal, don't do any more work
+	if(isGoal()) return;
+	
+	// Compute initial possible values for all cells
+	refreshDomains();
 }
 
 bool contains(const string& str, char search) {
 	return str.find(search) != string::npos;
 }
 
+// The smallest value in a set of values held as a bitmask (bit i for value i + 1)
+static int lowestValue(unsigned mask) {
+	int value(1);
+	while(!(mask & 1)) {
+		mask >>= 1;
+		++value;
+	}
+	
+	return value;
+}
+
 vector<int> splitRuleCell(const string& str) {
 	vector<int> result;
 	
@@ -159,17 +161,27 @@ vector<int> splitRuleCell(const string& str) {
 	return result;
 }
 
-KakuroConfig::KakuroConfig(string filename) : m_deltaI(0), m_deltaJ(0), m_isGoal(false), m_shouldDelta(false), m_parent(nullptr) {
+template <class Board>
+vector<vector<Cell>> BasicKakuroConfig<Board>::readBoard(const string& filename) {
 	fstream file;
 	file.open(filename);
 	
 	if(!file.good()) {
 		file.close();
 		cerr << "FATAL ERROR: bad file given to config when it should have been checked first" << endl;
-		return;
+		return vector<vector<Cell>>();
 	}
 	
-	int x, y;
+	vector<vector<Cell>> board = readBoard(file);
+	
+	file.close();
+	
+	return board;
+}
+
+template <class Board>
+vector<vector<Cell>> BasicKakuroConfig<Board>::readBoard(istream& file) {
+	int x(0), y(0);
 	file >> x;
 	file >> y;
 	
@@ -177,7 +189,7 @@ KakuroConfig::KakuroConfig(string filename) : m_deltaI(0), m_deltaJ(0), m_isGoal
                 cerr << "INVALID INPUT: " << endl;
                 cerr << "\tThe first two tokens must be positive integers representing the dimensions of the board." << endl;
                 cerr << "\tThe first dimension is vertical and the second horizontal." << endl;
-                return;
+                return vector<vector<Cell>>();
         }
 	
 	vector<vector<Cell>> board(x, vector<Cell>());
@@ -188,207 +200,1216 @@ KakuroConfig::KakuroConfig(string filename) : m_deltaI(0), m_deltaJ(0), m_isGoal
 			if(!(file >> cell)) {
 				cerr << "INVALID INPUT: " << endl;
 				cerr << "\tNot enough cells to read given the " << x << " by " << y << " dimensions from the input file!" << endl;
-				return ;
+				return vector<vector<Cell>>();
 			}
 			if(contains(cell, '\\')) {
+				// A sum left out (as in "5\") is no restriction
 				vector<int> rules = splitRuleCell(cell);
-				Cell ruleCell(rules[0], rules[1]);
+				Cell ruleCell(rules.size() > 0 ? rules[0] : 0, rules.size() > 1 ? rules[1] : 0);
 				board[i].push_back(ruleCell);
 			} else {
 				int val = atoi(cell.c_str());
 				Cell valCell(val, val > 0);
 				board[i].push_back(valCell);
 			}
+		
+		}
+	}
+	
+	return board;
+}
 
+template <class Board>
+void BasicKakuroConfig<Board>::writeBoard(ostream& os, const vector<vector<Cell>>& board) {
+	if(board.empty()) return;
+	
+	os << board.size() << " " << board[0].size() << endl;
+	
+	for(const vector<Cell>& row : board) {
+		for(unsigned j = 0; j < row.size(); ++j) {
+			if(j > 0) os << " ";
+			
+			if(row[j].isValueCell()) {
+				os << row[j].value();
+			} else {
+				os << row[j].downSum() << "\\" << row[j].rightSum();
+			}
 		}
+		
+		os << endl;
 	}
+}
 
-	file.close();
+template <class Board>
+BasicKakuroConfig<Board>::BasicKakuroConfig(string filename) : BasicKakuroConfig(readBoard(filename), false) {}
+
+template <class Board>
+const Cell& BasicKakuroConfig<Board>::cellAt(unsigned index) const {
+	return m_board.at(index / m_board.width(), index % m_board.width());
+}
+
+template <class Board>
+Cell& BasicKakuroConfig<Board>::editCell(unsigned index) {
+	return m_board.edit(index / m_board.width(), index % m_board.width());
+}
+
+template <class Board>
+void BasicKakuroConfig<Board>::addToBucket(unsigned index) {
+	TiledVector<unsigned>& bucket = m_buckets[cellAt(index).numPossibleValues()];
 	
-	m_board = board;
+	m_bucketPos.edit(index) = bucket.size();
+	bucket.push_back(index);
+}
+
+template <class Board>
+void BasicKakuroConfig<Board>::removeFromBucket(unsigned index) {
+	int pos = m_bucketPos[index];
+	if(pos == -1) return;
 	
-	// If our root config is the goal, don't do any more work
-	if(slowIsGoal()) {
-		m_isGoal = true;
-		return;
+	// Swap the last cell of the bucket into the hole so removal stays constant time
+	TiledVector<unsigned>& bucket = m_buckets[cellAt(index).numPossibleValues()];
+	unsigned last = bucket.back();
+	
+	bucket.edit(pos) = last;
+	m_bucketPos.edit(last) = pos;
+	bucket.pop_back();
+	
+	m_bucketPos.edit(index) = -1;
+}
+
+template <class Board>
+void BasicKakuroConfig<Board>::setDomain(unsigned index, array<bool, 9> values) {
+	removeFromBucket(index);
+	
+	// Leave a tile we still share with our parent alone if nothing changes
+	if(cellAt(index).possibleValues() != values) editCell(index).setPossibleValues(values);
+	addToBucket(index);
+}
+
+template <class Board>
+bool BasicKakuroConfig<Board>::runViolated(int run) const {
+	const RunState& state = m_runStates[run];
+	
+	if(state.duplicates > 0) return true;
+	
+	// Restricted runs must still be able to reach their sum with distinct values
+	if(m_runs->runs()[run].sum > 0) {
+		int low = state.unfilled * (state.unfilled + 1) / 2;
+		int high = state.unfilled * (19 - state.unfilled) / 2;
+		
+		return state.remaining < low || state.remaining > high;
 	}
 	
-	// Compute initial possible values for all cells
+	return false;
+}
+
+template <class Board>
+void BasicKakuroConfig<Board>::place(unsigned index, int value) {
+	removeFromBucket(index);
+	editCell(index) = Cell(value, cellAt(index).isFixed());
+	--m_unfilled;
+	
+	for(int run : {m_runs->horizontalRun(index), m_runs->verticalRun(index)}) {
+		if(run == -1) continue;
+		
+		RunState& state = m_runStates.edit(run);
+		bool wasViolated = runViolated(run);
+		
+		state.remaining -= value;
+		--state.unfilled;
+		if(state.counts[value - 1]++ > 0) ++state.duplicates;
+		
+		m_violations += int(runViolated(run)) - int(wasViolated);
+	}
+}
+
+template <class Board>
+void BasicKakuroConfig<Board>::unplace(unsigned index) {
+	int value = cellAt(index).value();
+	
+	// The cell's possible values are left for the caller to fill in before it goes back in a bucket
+	editCell(index) = Cell(0, cellAt(index).isFixed());
+	++m_unfilled;
+	
+	for(int run : {m_runs->horizontalRun(index), m_runs->verticalRun(index)}) {
+		if(run == -1) continue;
+		
+		RunState& state = m_runStates.edit(run);
+		bool wasViolated = runViolated(run);
+		
+		state.remaining += value;
+		++state.unfilled;
+		if(--state.counts[value - 1] > 0) --state.duplicates;
+		
+		m_violations += int(runViolated(run)) - int(wasViolated);
+	}
+}
+
+template <class Board>
+void BasicKakuroConfig<Board>::updatePeers(unsigned index, bool widen) {
+	for(int run : {m_runs->horizontalRun(index), m_runs->verticalRun(index)}) {
+		if(run == -1) continue;
+		
+		array<bool, 9> possibleRun = runPossibles(run);
+		bool horizontal = m_runs->runs()[run].horizontal;
+		
+		for(unsigned peer : m_runs->runs()[run].cells) {
+			const Cell& c = cellAt(peer);
+			if(c.value() != 0) continue;
+			
+			array<bool, 9> possibleCross = runPossibles(horizontal ? m_runs->verticalRun(peer) : m_runs->horizontalRun(peer));
+			array<bool, 9> possibleVals = Partitioner::getInstance().intersection(possibleRun, possibleCross);
+			
+			// Domains only ever shrink down a branch, so unless we're widening, anything already ruled out stays out
+			if(!widen) possibleVals = Partitioner::getInstance().intersection(possibleVals, c.possibleValues());
+			
+			if(m_bucketPos[peer] == -1) {
+				editCell(peer).setPossibleValues(possibleVals);
+				addToBucket(peer);
+			} else {
+				setDomain(peer, possibleVals);
+			}
+		}
+	}
+}
+
+template <class Board>
+void BasicKakuroConfig<Board>::refreshDomains() {
+	for(TiledVector<unsigned>& bucket : m_buckets) bucket.clear();
+	m_bucketPos = TiledVector<int>(m_bucketPos.size(), -1);
+	
+	m_contradiction = false;
+	m_stale = false;
+	
+	// Every combination of every run is back in play
+	for(unsigned run = 0; run < m_runs->runs().size(); ++run) {
+		const Run& r = m_runs->runs()[run];
+		m_runStates.edit(run).alive = (1 << Partitioner::getInstance().subsets(r.sum, r.cells.size()).size()) - 1;
+	}
 	
 	// The possible values for a cell are 
 	// the intersection of the integer partition sets 
 	// of each dimensional neighbor group with target sums 
 	// determined by the sum cells
-	for(unsigned i = 0; i < m_board.size(); ++i) {
-		for(unsigned j = 0; j < m_board.size(); ++j) {
-			Cell& cursor = m_board[i][j];
-			
-			if(cursor.isValueCell()) {
-				// Do two walks, horizontally and vertically
-				// Count the number of peers and establish target sums
-				// Then intersect possible values
+	for(unsigned i = 0; i < m_board.height(); ++i) {
+		for(unsigned j = 0; j < m_board.width(); ++j) {
+			if(m_board.at(i, j).isValueCell()) {
+				Cell& cursor = m_board.edit(i, j);
+				
+				// Intersect what the horizontal and vertical runs still allow
+				unsigned index = m_runs->index(i, j);
 				
-				array<bool, 9> horPossibles = availableValues(m_board, i, j, false);
-				array<bool, 9> verPossibles = availableValues(m_board, i, j, false);
+				array<bool, 9> horPossibles = runPossibles(m_runs->horizontalRun(index));
+				array<bool, 9> verPossibles = runPossibles(m_runs->verticalRun(index));
 				
 				array<bool, 9> cellPossibles = Partitioner::getInstance().intersection(horPossibles, verPossibles);
 				
 				cursor.setPossibleValues(cellPossibles);
+				
+				// Unfilled cells are bucketed by how many values they can still take
+				if(cursor.value() == 0) addToBucket(index);
+			}
+		}
+	}
+	
+	// Then let every run's sum bounds and combinations tighten those values further
+	if(m_context->options().propagateBounds || m_context->options().propagateCombinations) {
+		vector<int> pending;
+		for(unsigned run = 0; run < m_runs->runs().size(); ++run) pending.push_back(run);
+		
+		if(!propagate(pending)) m_contradiction = true;
+	}
+}
+
+template <class Board>
+void BasicKakuroConfig<Board>::runState(int run, int& remaining, int& unfilled, array<bool, 9>& used) const {
+	const RunState& state = m_runStates[run];
+	
+	remaining = state.remaining;
+	unfilled = state.unfilled;
+	
+	for(int i = 0; i < 9; ++i) {
+		used[i] = state.counts[i] > 0;
+	}
+}
+
+template <class Board>
+bool BasicKakuroConfig<Board>::boundRun(int run, vector<unsigned>& domains) const {
+	const Run& r = m_runs->runs()[run];
+	
+	// No more than 9 cells can hold distinct digits (and the bounds below have room for no more)
+	if(r.cells.size() > 9) return false;
+	
+	// With the smallest and largest values every unfilled cell can still take summed up,
+	// a cell needs at least what its peers can't cover at their largest and at most what's left at their smallest
+	int lowTotal(0), highTotal(0);
+	array<int, 9> low{}, high{};
+	
+	for(unsigned k = 0; k < r.cells.size(); ++k) {
+		if(cellAt(r.cells[k]).value() != 0) continue;
+		if(domains[k] == 0) return false;
+		
+		for(low[k] = 1; !(domains[k] & (1 << (low[k] - 1))); ++low[k]);
+		for(high[k] = 9; !(domains[k] & (1 << (high[k] - 1))); --high[k]);
+		
+		lowTotal += low[k];
+		highTotal += high[k];
+	}
+	
+	int remaining = m_runStates[run].remaining;
+	
+	for(unsigned k = 0; k < r.cells.size(); ++k) {
+		if(cellAt(r.cells[k]).value() != 0) continue;
+		
+		int atLeast = remaining - (highTotal - high[k]);
+		int atMost = remaining - (lowTotal - low[k]);
+		
+		for(int val = 1; val <= 9; ++val) {
+			if(val < atLeast || val > atMost) domains[k] &= ~(1 << (val - 1));
+		}
+		
+		if(domains[k] == 0) return false;
+	}
+	
+	return true;
+}
+
+template <class Board>
+bool BasicKakuroConfig<Board>::combineRun(int run, vector<unsigned>& domains) {
+	const Run& r = m_runs->runs()[run];
+	const RunState& state = m_runStates[run];
+	
+	// The run's state is only written (and its tile copied) if a combination dies
+	unsigned short alive = state.alive;
+	
+	unsigned used(0), reachable(0);
+	for(int i = 0; i < 9; ++i) {
+		if(state.counts[i] > 0) used |= 1 << i;
+	}
+	
+	for(unsigned k = 0; k < r.cells.size(); ++k) {
+		if(cellAt(r.cells[k]).value() == 0) reachable |= domains[k];
+	}
+	
+	// Drop combinations that miss a placed value, need a value no unfilled cell can take, or leave some unfilled cell nothing
+	const vector<unsigned short>& subsets = Partitioner::getInstance().subsets(r.sum, r.cells.size());
+	unsigned allowed(0), required(0x1FF);
+	
+	for(unsigned k = 0; k < subsets.size(); ++k) {
+		if(!(alive & (1 << k))) continue;
+		
+		unsigned open = subsets[k] & ~used;
+		bool feasible = (subsets[k] & used) == used && (open & ~reachable) == 0;
+		
+		for(unsigned c = 0; c < r.cells.size() && feasible; ++c) {
+			if(cellAt(r.cells[c]).value() == 0 && (domains[c] & open) == 0) feasible = false;
+		}
+		
+		if(!feasible) {
+			alive &= ~(1 << k);
+			continue;
+		}
+		
+		allowed |= open;
+		required &= open;
+	}
+	
+	if(alive != state.alive) m_runStates.edit(run).alive = alive;
+	
+	if(alive == 0) return false;
+	
+	// Every unfilled cell must take a value some combination still allows
+	for(unsigned k = 0; k < r.cells.size(); ++k) {
+		domains[k] &= allowed;
+	}
+	
+	// A value every combination needs must go somewhere; if only one cell can take it, that cell must
+	for(int i = 0; i < 9; ++i) {
+		if(!(required & (1 << i))) continue;
+		
+		int places(0);
+		unsigned place(0);
+		
+		for(unsigned k = 0; k < r.cells.size(); ++k) {
+			if(domains[k] & (1 << i)) {
+				++places;
+				place = k;
+			}
+		}
+		
+		if(places == 0) return false;
+		
+		if(places == 1) domains[place] = 1 << i;
+	}
+	
+	return true;
+}
+
+template <class Board>
+bool BasicKakuroConfig<Board>::propagate(vector<int> pending) {
+	const SearchOptions& options = m_context->options();
+	
+	// Each run is queued at most once at a time
+	vector<bool> queued(m_runs->runs().size(), false);
+	vector<int> unique;
+	
+	for(int run : pending) {
+		if(!queued[run]) {
+			queued[run] = true;
+			unique.push_back(run);
+		}
+	}
+	
+	pending.swap(unique);
+	
+	vector<unsigned> domains;
+	
+	while(!pending.empty()) {
+		int run = pending.back();
+		pending.pop_back();
+		queued[run] = false;
+		
+		const Run& r = m_runs->runs()[run];
+		
+		// Unrestricted runs have no sum to reason about
+		if(r.sum <= 0) continue;
+		
+		// Work on the run's domains as bitmasks, then write back whatever shrank
+		domains.clear();
+		for(unsigned index : r.cells) {
+			const Cell& c = cellAt(index);
+			domains.push_back(c.value() == 0 ? Partitioner::toMask(c.possibleValues()) : 0);
+		}
+		
+		bool feasible = (!options.propagateBounds || boundRun(run, domains)) && (!options.propagateCombinations || combineRun(run, domains));
+		
+		if(!feasible) {
+			m_context->bumpRunWeight(run);
+			return false;
+		}
+		
+		bool changed(false);
+		
+		for(unsigned k = 0; k < r.cells.size(); ++k) {
+			unsigned index = r.cells[k];
+			if(cellAt(index).value() != 0 || domains[k] == Partitioner::toMask(cellAt(index).possibleValues())) continue;
+			
+			if(domains[k] == 0) {
+				m_context->bumpRunWeight(run);
+				return false;
+			}
+			
+			setDomain(index, Partitioner::fromMask(domains[k]));
+			changed = true;
+			
+			// The crossing run now has less to work with
+			int cross = r.horizontal ? m_runs->verticalRun(index) : m_runs->horizontalRun(index);
+			if(cross != -1 && !queued[cross]) {
+				queued[cross] = true;
+				pending.push_back(cross);
+			}
+		}
+		
+		// Narrower cells may narrow our own cells further
+		if(changed && !queued[run]) {
+			queued[run] = true;
+			pending.push_back(run);
+		}
+	}
+	
+	return true;
+}
+
+template <class Board>
+array<bool, 9> BasicKakuroConfig<Board>::runPossibles(int run) const {
+	array<bool, 9> possibles;
+	
+	// A cell outside any run in this direction is unrestricted by it
+	if(run == -1) {
+		possibles.fill(true);
+		return possibles;
+	}
+	
+	int remaining, unfilled;
+	array<bool, 9> used;
+	runState(run, remaining, unfilled, used);
+	
+	// The partitioner reads a sum of 0 or less as unrestricted, which a restricted run that's overshot is not
+	if(m_runs->runs()[run].sum > 0 && remaining <= 0) {
+		possibles.fill(false);
+		return possibles;
+	}
+	
+	return Partitioner::getInstance().possibleValues(remaining, unfilled, used);
+}
+
+template <class Board>
+int BasicKakuroConfig<Board>::unfilledPeers(unsigned index) const {
+	int peers(0);
+	
+	// The cell itself is unfilled, so it's one of its runs' unfilled cells
+	for(int run : {m_runs->horizontalRun(index), m_runs->verticalRun(index)}) {
+		if(run != -1) peers += m_runStates[run].unfilled - 1;
+	}
+	
+	return peers;
+}
+
+template <class Board>
+unsigned BasicKakuroConfig<Board>::weightedDegree(unsigned index) const {
+	unsigned weight(0);
+	
+	for(int run : {m_runs->horizontalRun(index), m_runs->verticalRun(index)}) {
+		if(run == -1) continue;
+		
+		// Only runs that still constrain another unfilled cell count towards the degree
+		if(m_runStates[run].unfilled > 1) weight += m_context->runWeight(run);
+	}
+	
+	return weight;
+}
+
+template <class Board>
+bool BasicKakuroConfig<Board>::selectCell(unsigned& ver, unsigned& hor, int& competitors) {
+	CellOrdering ordering = m_context->options().cellOrdering;
+	
+	competitors = 0;
+	for(const TiledVector<unsigned>& bucket : m_buckets) competitors += bucket.size();
+	
+	// A cell that can't be filled makes this config a dead end, whatever the ordering
+	if(!m_buckets[0].empty()) {
+		// Blame the cell's runs so dom/wdeg steers towards them next time
+		if(ordering == CellOrdering::DomWDeg) {
+			for(unsigned index : m_buckets[0]) {
+				if(m_runs->horizontalRun(index) != -1) m_context->bumpRunWeight(m_runs->horizontalRun(index));
+				if(m_runs->verticalRun(index) != -1) m_context->bumpRunWeight(m_runs->verticalRun(index));
+			}
+		}
+		
+		return false;
+	}
+	
+	int chosen(-1);
+	unsigned ties(1);
+	
+	// For tightest-run-first, take the smallest-domain cell of the constrained run with the fewest combinations left for its sum
+	if(ordering == CellOrdering::TightestRun) {
+		int fewestCombos(-1);
+		int tightest(-1);
+		
+		for(unsigned run = 0; run < m_runs->runs().size(); ++run) {
+			if(m_runs->runs()[run].sum <= 0) continue;
+			
+			int remaining, unfilled;
+			array<bool, 9> used;
+			runState(run, remaining, unfilled, used);
+			
+			if(unfilled == 0) continue;
+			
+			// Skip runs whose unfilled cells belong to another part of a split config
+			bool ours(false);
+			for(unsigned index : m_runs->runs()[run].cells) {
+				if(m_bucketPos[index] != -1) {
+					ours = true;
+					break;
+				}
+			}
+			
+			if(!ours) continue;
+			
+			int combos = Partitioner::getInstance().numCombinations(remaining, unfilled, used);
+			
+			if(fewestCombos == -1 || combos < fewestCombos) {
+				fewestCombos = combos;
+				tightest = run;
+				ties = 1;
+			} else if(combos == fewestCombos && breakTie(ties)) {
+				tightest = run;
+			}
+		}
+		
+		if(tightest != -1) {
+			int fewestNum(-1);
+			
+			for(unsigned index : m_runs->runs()[tightest].cells) {
+				if(m_bucketPos[index] == -1) continue;
+				
+				int num = cellAt(index).numPossibleValues();
+				if(fewestNum == -1 || num < fewestNum) {
+					fewestNum = num;
+					chosen = index;
+					ties = 1;
+				} else if(num == fewestNum && breakTie(ties)) {
+					chosen = index;
+				}
 			}
 		}
 	}
+	
+	// The smallest non-empty bucket holds the cells with the fewest possible values
+	unsigned fewestNum(1);
+	while(fewestNum <= 9 && m_buckets[fewestNum].empty()) ++fewestNum;
+	
+	if(fewestNum > 9) return false;
+	
+	if(ordering == CellOrdering::MinRemainingDegree) {
+		int bestDegree(-1);
+		
+		for(unsigned index : m_buckets[fewestNum]) {
+			int degree = unfilledPeers(index);
+			if(degree > bestDegree) {
+				bestDegree = degree;
+				chosen = index;
+				ties = 1;
+			} else if(degree == bestDegree && breakTie(ties)) {
+				chosen = index;
+			}
+		}
+	} else if(ordering == CellOrdering::DomWDeg) {
+		double bestScore(0);
+		
+		for(unsigned num = fewestNum; num <= 9; ++num) {
+			for(unsigned index : m_buckets[num]) {
+				unsigned weight = weightedDegree(index);
+				double score = double(num) / (weight > 0 ? weight : 1);
+				if(chosen == -1 || score < bestScore) {
+					bestScore = score;
+					chosen = index;
+					ties = 1;
+				} else if(score == bestScore && breakTie(ties)) {
+					chosen = index;
+				}
+			}
+		}
+	} else if(chosen == -1) {
+		const TiledVector<unsigned>& bucket = m_buckets[fewestNum];
+		chosen = m_context->options().randomTies ? bucket[random(bucket.size())] : bucket.front();
+	}
+	
+	ver = chosen / m_runs->width();
+	hor = chosen % m_runs->width();
+	
+	return true;
 }
 
-bool KakuroConfig::isGoal() const {
-	return m_isGoal;
+template <class Board>
+int BasicKakuroConfig<Board>::combinationsWith(int run, int value) const {
+	// Unrestricted runs don't prefer any value
+	if(run == -1 || m_runs->runs()[run].sum <= 0) return 1;
+	
+	int remaining, unfilled;
+	array<bool, 9> used;
+	runState(run, remaining, unfilled, used);
+	
+	if(used[value - 1]) return 0;
+	
+	used[value - 1] = true;
+	
+	return Partitioner::getInstance().numCombinations(remaining - value, unfilled - 1, used);
 }
 
-vector<shared_ptr<KakuroConfig>> KakuroConfig::getSuccessors() {
-	vector<shared_ptr<KakuroConfig>> successors;
+template <class Board>
+vector<int> BasicKakuroConfig<Board>::orderValues(unsigned ver, unsigned hor, array<bool, 9> values) {
+	vector<int> candVals;
+	for(int i = 0; i < 9; ++i) if(values[i]) candVals.push_back(i + 1);
+	
+	// Shuffling first leaves equally good values in random order after the (stable) sort below
+	if(m_context->options().randomTies) {
+		for(unsigned k = candVals.size(); k > 1; --k) {
+			swap(candVals[k - 1], candVals[random(k)]);
+		}
+	}
+	
+	if(m_context->options().valueOrdering == ValueOrdering::LeastConstraining && candVals.size() > 1) {
+		unsigned index = m_runs->index(ver, hor);
+		
+		// Score each value by the combinations it leaves open across both runs, then try the highest scores first
+		array<long, 10> score{};
+		for(int val : candVals) {
+			score[val] = long(combinationsWith(m_runs->horizontalRun(index), val)) * combinationsWith(m_runs->verticalRun(index), val);
+		}
+		
+		stable_sort(candVals.begin(), candVals.end(), [&score](int a, int b) { return score[a] > score[b]; });
+	}
+	
+	return candVals;
+}
+
+template <class Board>
+unsigned BasicKakuroConfig<Board>::random(unsigned n) {
+	// splitmix64; each config carries its own state, so the draws along a path are the same whatever thread runs it
+	uint64_t z = (m_rngState += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	
+	return (z ^ (z >> 31)) % n;
+}
+
+template <class Board>
+bool BasicKakuroConfig<Board>::breakTie(unsigned& ties) {
+	// Reservoir sampling: the k-th equally good candidate replaces the current pick with probability 1/k
+	return m_context->options().randomTies && random(++ties) == 0;
+}
+
+template <class Board>
+void BasicKakuroConfig<Board>::reseed(unsigned attempt) {
+	m_rngState = (uint64_t(m_context->options().seed) << 32) ^ attempt;
+}
+
+template <class Board>
+void BasicKakuroConfig<Board>::setSearchOptions(const SearchOptions& options) {
+	m_context = make_shared<SearchContext>(options, m_runs->runs().size());
+	reseed(0);
+	
+	// The possible values were propagated under the old options, so they're worked out again under the new ones
+	if(!isGoal()) refreshDomains();
+}
+
+template <class Board>
+const SearchOptions& BasicKakuroConfig<Board>::searchOptions() const {
+	return m_context->options();
+}
+
+template <class Board>
+uint64_t BasicKakuroConfig<Board>::randomState() const {
+	return m_rngState;
+}
+
+template <class Board>
+void BasicKakuroConfig<Board>::setRandomState(uint64_t state) {
+	m_rngState = state;
+}
+
+template <class Board>
+vector<unsigned> BasicKakuroConfig<Board>::runWeights() const {
+	return m_context->runWeights();
+}
+
+template <class Board>
+void BasicKakuroConfig<Board>::setRunWeights(const vector<unsigned>& weights) {
+	m_context->setRunWeights(weights);
+}
+
+template <class Board>
+bool BasicKakuroConfig<Board>::isGoal() const {
+	// An empty board comes from unreadable input and is never a goal
+	return !m_board.empty() && m_unfilled == 0 && m_violations == 0;
+}
+
+template <class Board>
+bool BasicKakuroConfig<Board>::isConsistent() const {
+	return m_violations == 0 && !m_contradiction;
+}
+
+template <class Board>
+vector<shared_ptr<BasicKakuroConfig<Board>>> BasicKakuroConfig<Board>::getSuccessors() {
+	vector<shared_ptr<BasicKakuroConfig>> successors;
+	
+	// Possible values an edit may have left too narrow are rebuilt first
+	if(m_stale) refreshDomains();
+	
+	// A config already known to be broken has no future
+	if(!isConsistent()) return successors;
 	
 	// PHASE 1: 
-	// Find the cell with the fewest possible values; this will be the mutated cell for our next branch
+	// Pick the cell to mutate for our next branch using the search's cell ordering
 	int competitors(0);
 	unsigned fewestHor(0), fewestVer(0);
-	int fewestNum(-1);
 	array<bool, 9> values{};
 	
-	for(unsigned i = 0; i < m_board.size(); ++i) {
-		for(unsigned j = 0; j < m_board[0].size(); ++j) {
-			Cell& candidate = m_board.at(i).at(j);
-			if(candidate.value() == 0) {
-				++competitors;
-				
-				if(candidate.numPossibleValues() >= fewestNum && fewestNum != -1) continue;
-				
-				if(candidate.numPossibleValues() == 0) continue;
-				
-				fewestNum = candidate.numPossibleValues();
-				fewestHor = j;
-				fewestVer = i;
-				values = candidate.possibleValues();
-			}
-		}
+	if(selectCell(fewestVer, fewestHor, competitors)) {
+		values = m_board.at(fewestVer, fewestHor).possibleValues();
 	}
 	
 	// PHASE 2:
 	// Begin generating successors, updating the values of neighbors as we try new candidate values
 	
-	// Put candidate values into a vector
-	vector<int> candVals;
-	for(int i = 0; i < 9; ++i) if(values[i]) candVals.push_back(i + 1);
+	// Put candidate values into a vector, in the order the search asks for
+	vector<int> candVals = orderValues(fewestVer, fewestHor, values);
+	
+	return successorsAt(m_runs->index(fewestVer, fewestHor), candVals);
+}
+
+template <class Board>
+vector<shared_ptr<BasicKakuroConfig<Board>>> BasicKakuroConfig<Board>::getSuccessors(unsigned index, const vector<int>& values) {
+	// The same preparation as getSuccessors, without picking a cell (which must be an unfilled value cell)
+	if(m_stale) refreshDomains();
+	if(!isConsistent() || index >= m_bucketPos.size() || m_bucketPos[index] == -1) return vector<shared_ptr<BasicKakuroConfig>>();
+	
+	return successorsAt(index, values);
+}
+
+template <class Board>
+vector<shared_ptr<BasicKakuroConfig<Board>>> BasicKakuroConfig<Board>::successorsAt(unsigned index, const vector<int>& candVals) {
+	vector<shared_ptr<BasicKakuroConfig>> successors;
+	
+	unsigned fewestVer = index / m_runs->width(), fewestHor = index % m_runs->width();
+	int horRun = m_runs->horizontalRun(index);
+	int verRun = m_runs->verticalRun(index);
 	
 	for(int candVal : candVals) {
-		shared_ptr<KakuroConfig> succ = make_shared<KakuroConfig>(*this);
-			
-		// Change the candidate cell to the candidate value
-		succ->m_board[fewestVer][fewestHor] = Cell(candVal, m_board[fewestVer][fewestHor].isFixed());
+		shared_ptr<BasicKakuroConfig> succ = make_shared<BasicKakuroConfig>(*this);
+		
+		// Change the candidate cell to the candidate value, updating its runs' sums and our goal tallies
+		succ->place(index, candVal);
 		
 		// Update delta metadata for better printouts
 		succ->m_deltaI = fewestVer;
 		succ->m_deltaJ = fewestHor;
+		succ->m_deltaValue = candVal;
 		
-		// Now update the possible values of all neighbors
+		// A value that breaks one of the runs can't lead anywhere
+		if(!succ->isConsistent()) continue;
 		
-		// ...unless we won, in which case we're okay!
-		// Make sure we actually won, though, in case the initial values were bad.
-		if(competitors == 1 && succ->slowIsGoal()) {
-			succ->m_isGoal = true;
+		// If we won, there's nothing left to update
+		if(succ->isGoal()) {
 			successors.push_back(succ);
 			return successors;
 		}
 		
-		// First, find the sum cells that initiate the group
-		unsigned horPtr(fewestHor), verPtr(fewestVer);
-		
-		while(succ->m_board[fewestVer][--horPtr].isValueCell());
-		while(succ->m_board[--verPtr][fewestHor].isValueCell());
-		
-		int downSum = succ->m_board[verPtr][fewestHor].downSum();
-		int rightSum = m_board[fewestVer][horPtr].rightSum();
-		
-		// Now count what's already used in each peer group
-		unsigned horPtr2(horPtr), verPtr2(verPtr);
-		int numHorPeers(0), numVerPeers(0);
-		array<bool, 9> usedHor{};
-		int curHorSum(0), curVerSum(0);
-		array<bool, 9> usedVer{};
-		while(horPtr2+1 < succ->m_board[0].size() && succ->m_board[fewestVer][++horPtr2].isValueCell()) {
-			int val = succ->m_board[fewestVer][horPtr2].value();
-			if(val > 0) {
-				usedHor[val - 1] = true;
-				curHorSum += val;
-			} else ++numHorPeers;
-		}
-		while(verPtr2+1 < succ->m_board.size() && succ->m_board[++verPtr2][fewestHor].isValueCell()) {
-			int val = succ->m_board[verPtr2][fewestHor].value();
-			if(val > 0) {
-				usedVer[val - 1] = true;
-				curVerSum += val;
-			} else ++numVerPeers;
+		// Now update the possible values of all neighbors
+		succ->updatePeers(index, false);
+		
+		// Then follow the consequences through the rest of the board, starting from the two runs and the runs crossing them
+		if(m_context->options().propagateBounds || m_context->options().propagateCombinations) {
+			vector<int> pending;
+			
+			for(int run : {horRun, verRun}) {
+				if(run == -1) continue;
+				
+				pending.push_back(run);
+				
+				for(unsigned peer : m_runs->runs()[run].cells) {
+					int cross = (run == horRun) ? m_runs->verticalRun(peer) : m_runs->horizontalRun(peer);
+					if(peer != index && cross != -1 && succ->cellAt(peer).value() == 0) pending.push_back(cross);
+				}
+			}
+			
+			if(!succ->propagate(pending)) continue;
+		}
+		
+		// All good; add the candidate to the list!
+		successors.push_back(succ);
+	}
+	
+	return successors;
+}
+
+template <class Board>
+vector<shared_ptr<BasicKakuroConfig<Board>>> BasicKakuroConfig<Board>::splitComponents() const {
+	vector<shared_ptr<BasicKakuroConfig>> parts;
+	
+	// A config with stale possible values rebuilds them for every cell when it branches, so it can't be narrowed to a part yet
+	if(!m_context->options().decompose || !isConsistent() || m_stale) return parts;
+	
+	// Label the unfilled cells by flood-filling across the runs they share
+	vector<int> label(m_bucketPos.size(), -1);
+	int numComponents(0);
+	vector<unsigned> stack;
+	
+	for(const TiledVector<unsigned>& bucket : m_buckets) {
+		for(unsigned start : bucket) {
+			if(label[start] != -1) continue;
+			
+			label[start] = numComponents;
+			stack.push_back(start);
+			
+			while(!stack.empty()) {
+				unsigned index = stack.back();
+				stack.pop_back();
+				
+				for(int run : {m_runs->horizontalRun(index), m_runs->verticalRun(index)}) {
+					if(run == -1) continue;
+					
+					for(unsigned peer : m_runs->runs()[run].cells) {
+						if(m_bucketPos[peer] != -1 && label[peer] == -1) {
+							label[peer] = numComponents;
+							stack.push_back(peer);
+						}
+					}
+				}
+			}
 			
+			++numComponents;
 		}
+	}
+	
+	if(numComponents < 2) return parts;
+	
+	// Each part keeps only its own cells in its buckets, so it never branches on the others
+	for(int k = 0; k < numComponents; ++k) {
+		shared_ptr<BasicKakuroConfig> part = make_shared<BasicKakuroConfig>(*this);
+		part->m_rngState ^= uint64_t(k + 1) << 48;
 		
-		// Get new possible values with this info
-		array<bool, 9> possibleHor = Partitioner::getInstance().possibleValues(rightSum - curHorSum, numHorPeers, usedHor);
-		array<bool, 9> possibleVer = Partitioner::getInstance().possibleValues(downSum - curVerSum, numVerPeers, usedVer);
+		for(TiledVector<unsigned>& bucket : part->m_buckets) bucket.clear();
+		part->m_unfilled = 0;
 		
-		// Set new possible vals for all horizontal and vertical peers
-		while(horPtr+1 < succ->m_board[0].size()) {
-			Cell& c = succ->m_board[fewestVer][++horPtr];
-			if(c.isValueCell()) {
-				if(c.value() == 0) {
-					array<bool, 9> possibleVer = availableValues(succ->m_board, fewestVer, horPtr, true);
-					array<bool, 9> possibleVals = Partitioner::getInstance().intersection(possibleHor, possibleVer);
-					c.setPossibleValues(possibleVals);
+		for(const TiledVector<unsigned>& bucket : m_buckets) {
+			for(unsigned index : bucket) {
+				part->m_bucketPos.edit(index) = -1;
+				
+				if(label[index] == k) {
+					part->addToBucket(index);
+					++part->m_unfilled;
 				}
-			} else break;
+			}
 		}
 		
-		while(verPtr + 1 < succ->m_board.size()) {
-			Cell& c = succ->m_board[++verPtr][fewestHor];
-			if(c.isValueCell()) {
-				if(c.value() == 0) {
-					array<bool, 9> possibleHor = availableValues(succ->m_board, verPtr, fewestHor, false);
-					array<bool, 9> possibleVals = Partitioner::getInstance().intersection(possibleHor, possibleVer);
-					c.setPossibleValues(possibleVals);
+		parts.push_back(part);
+	}
+	
+	// Smaller parts go first; they're the cheapest way to find out the whole config is a dead end
+	stable_sort(parts.begin(), parts.end(), [](const shared_ptr<BasicKakuroConfig>& a, const shared_ptr<BasicKakuroConfig>& b) { return a->m_unfilled < b->m_unfilled; });
+	
+	return parts;
+}
+
+template <class Board>
+shared_ptr<BasicKakuroConfig<Board>> BasicKakuroConfig<Board>::mergeComponents(const BasicKakuroConfig<Board>& whole, const vector<shared_ptr<BasicKakuroConfig<Board>>>& parts) {
+	shared_ptr<BasicKakuroConfig> merged = make_shared<BasicKakuroConfig>(whole);
+	merged->m_deltaValue = 0;
+	
+	for(const shared_ptr<BasicKakuroConfig>& part : parts) {
+		for(const TiledVector<unsigned>& bucket : whole.m_buckets) {
+			for(unsigned index : bucket) {
+				int val = part->cellAt(index).value();
+				if(val > 0 && merged->cellAt(index).value() == 0) merged->place(index, val);
+			}
+		}
+	}
+	
+	return merged;
+}
+
+template <class Board>
+bool BasicKakuroConfig<Board>::setCell(unsigned row, unsigned col, int value) {
+	if(value == 0) return clearCell(row, col);
+	
+	if(row >= m_board.height() || col >= m_board.width() || value < 1 || value > 9) return false;
+	
+	const Cell& c = m_board.at(row, col);
+	if(!c.isValueCell() || c.isFixed()) return false;
+	
+	if(c.value() == value) return true;
+	
+	unsigned index = m_runs->index(row, col);
+	
+	// Changing a value is clearing it and filling it again
+	if(c.value() != 0) clearCell(row, col);
+	
+	// Filling a cell only rules values out, so everything already ruled out stays that way
+	place(index, value);
+	updatePeers(index, false);
+	
+	return true;
+}
+
+template <class Board>
+bool BasicKakuroConfig<Board>::clearCell(unsigned row, unsigned col) {
+	if(row >= m_board.height() || col >= m_board.width()) return false;
+	
+	const Cell& c = m_board.at(row, col);
+	if(!c.isValueCell() || c.isFixed()) return false;
+	
+	if(c.value() == 0) return true;
+	
+	unsigned index = m_runs->index(row, col);
+	
+	unplace(index);
+	updatePeers(index, true);
+	
+	// Propagation may have ruled values out elsewhere because of the old value; that's put right on the next branch
+	m_contradiction = false;
+	m_stale = true;
+	
+	return true;
+}
+
+template <class Board>
+Hint BasicKakuroConfig<Board>::hint() const {
+	Hint none{-1, -1, 0, HintRule::None};
+	
+	// A board with a broken run forces nothing worth showing
+	if(m_board.empty() || isGoal() || m_violations > 0) return none;
+	
+	unsigned width = m_board.width();
+	
+	// A wrong entry can leave a board with forced-looking values that no solution has, so nothing is hinted unless it can still be solved as it stands
+	// The copy is propagated from scratch with every propagator on, so rule 3 below only counts what the runs force
+	BasicKakuroConfig scratch(*this);
+	
+	SearchOptions options = m_context->options();
+	options.propagateBounds = true;
+	options.propagateCombinations = true;
+	scratch.setSearchOptions(options);
+	
+	if(scratch.m_contradiction || !scratch.m_buckets[0].empty()) return none;
+	
+	Solver<BasicKakuroConfig, NoStats> solver(make_shared<BasicKakuroConfig>(scratch));
+	if(solver.isFailure()) return none;
+	
+	// What each run still allows its empty cells, going by its sum and the values already in it
+	vector<unsigned> runMasks(m_runs->runs().size());
+	for(unsigned run = 0; run < runMasks.size(); ++run) runMasks[run] = Partitioner::toMask(runPossibles(run));
+	
+	// RULE 1:
+	// An empty cell only one value fits in both of its runs
+	vector<unsigned> candidates(m_board.height() * width, 0);
+	
+	for(unsigned index = 0; index < candidates.size(); ++index) {
+		const Cell& c = cellAt(index);
+		if(!c.isValueCell() || c.value() != 0) continue;
+		
+		unsigned mask(0x1FF);
+		for(int run : {m_runs->horizontalRun(index), m_runs->verticalRun(index)}) {
+			if(run != -1) mask &= runMasks[run];
+		}
+		
+		if(mask == 0) return none;
+		
+		if((mask & (mask - 1)) == 0) return Hint{int(index / width), int(index % width), lowestValue(mask), HintRule::SingleCandidate};
+		
+		candidates[index] = mask;
+	}
+	
+	// RULE 2:
+	// A value every combination left to a run needs, which only one of the run's empty cells can take
+	for(unsigned run = 0; run < m_runs->runs().size(); ++run) {
+		const Run& r = m_runs->runs()[run];
+		const RunState& state = m_runStates[run];
+		
+		if(r.sum <= 0 || state.unfilled == 0) continue;
+		
+		unsigned used(0);
+		for(int i = 0; i < 9; ++i) {
+			if(state.counts[i] > 0) used |= 1 << i;
+		}
+		
+		unsigned required(0x1FF);
+		bool feasible(false);
+		
+		for(unsigned short subset : Partitioner::getInstance().subsets(r.sum, r.cells.size())) {
+			if((subset & used) != used) continue;
+			
+			required &= subset & ~used;
+			feasible = true;
+		}
+		
+		if(!feasible) return none;
+		
+		for(int i = 0; i < 9; ++i) {
+			if(!(required & (1 << i))) continue;
+			
+			int places(0);
+			unsigned place(0);
+			
+			for(unsigned index : r.cells) {
+				if(candidates[index] & (1 << i)) {
+					++places;
+					place = index;
 				}
-			} else break;
+			}
+			
+			if(places == 0) return none;
+			
+			if(places == 1) return Hint{int(place / width), int(place % width), i + 1, HintRule::OnlyPlace};
 		}
+	}
+	
+	// RULE 3:
+	// A value the propagated copy leaves a cell with
+	if(!scratch.m_buckets[1].empty()) {
+		unsigned index = *min_element(scratch.m_buckets[1].begin(), scratch.m_buckets[1].end());
+		int value = lowestValue(Partitioner::toMask(scratch.cellAt(index).possibleValues()));
 		
-		// All good; add the candidate to the list!
-		successors.push_back(succ);
+		return Hint{int(index / width), int(index % width), value, HintRule::Propagation};
 	}
 	
+	// FALLBACK:
+	// Nothing is forced, so hint the value the solution found above gives the cell with the fewest possible values
+	for(const TiledVector<unsigned>& bucket : scratch.m_buckets) {
+		if(bucket.empty()) continue;
+		
+		unsigned index = *min_element(bucket.begin(), bucket.end());
+		int value = solver.getSolutionPath().front()->cellAt(index).value();
+		
+		return Hint{int(index / width), int(index % width), value, HintRule::Search};
+	}
 	
-	return successors;
+	return none;
+}
+
+template <class Board>
+void BasicKakuroConfig<Board>::countConflicts(const vector<pair<unsigned, int>>& entries, int& placed, int& forced) const {
+	placed = forced = 0;
+	
+	for(const pair<unsigned, int>& entry : entries) {
+		const Cell& c = cellAt(entry.first);
+		
+		if(c.value() != 0) {
+			if(c.value() != entry.second) ++placed;
+		} else if(m_bucketPos[entry.first] != -1 && !c.possibleValues()[entry.second - 1]) {
+			++forced;
+		}
+	}
+}
+
+template <class Board>
+int BasicKakuroConfig<Board>::leastConflicts(const shared_ptr<BasicKakuroConfig>& config, const vector<pair<unsigned, int>>& entries, int bound, shared_ptr<BasicKakuroConfig>& best) {
+	int placed, forced;
+	config->countConflicts(entries, placed, forced);
+	
+	// Every solution below disagrees with the entries already placed wrong and those propagation has ruled out
+	if(placed + forced >= bound) return bound;
+	
+	if(config->isGoal()) {
+		best = config;
+		return placed;
+	}
+	
+	// Parts share no runs, so each part's extra conflicts are minimized on its own, within what the bound leaves after the other parts' lower bounds
+	vector<shared_ptr<BasicKakuroConfig>> parts = config->splitComponents();
+	
+	if(!parts.empty()) {
+		vector<int> extra;
+		
+		for(const shared_ptr<BasicKakuroConfig>& part : parts) {
+			int partPlaced, partForced;
+			part->countConflicts(entries, partPlaced, partForced);
+			extra.push_back(partForced);
+		}
+		
+		int total = placed + forced;
+		vector<shared_ptr<BasicKakuroConfig>> solved;
+		
+		for(unsigned k = 0; k < parts.size(); ++k) {
+			total -= extra[k];
+			
+			shared_ptr<BasicKakuroConfig> partBest;
+			int partBound = bound - (total - placed);
+			int partConflicts = leastConflicts(parts[k], entries, partBound, partBest);
+			
+			if(partConflicts >= partBound) return bound;
+			
+			total += partConflicts - placed;
+			solved.push_back(partBest);
+		}
+		
+		best = mergeComponents(*config, solved);
+		return total;
+	}
+	
+	vector<shared_ptr<BasicKakuroConfig>> successors = config->getSuccessors();
+	
+	// Trying the entry's own value first finds a solution agreeing with it early, which keeps the bound tight
+	int cell = successors.empty() ? -1 : successors.front()->deltaCell();
+	
+	for(const pair<unsigned, int>& entry : entries) {
+		if(int(entry.first) != cell) continue;
+		
+		stable_partition(successors.begin(), successors.end(), [&entry](const shared_ptr<BasicKakuroConfig>& succ) { return succ->deltaValue() == entry.second; });
+		break;
+	}
+	
+	for(const shared_ptr<BasicKakuroConfig>& succ : successors) {
+		shared_ptr<BasicKakuroConfig> found;
+		int conflicts = leastConflicts(succ, entries, bound, found);
+		
+		if(conflicts < bound) {
+			bound = conflicts;
+			best = found;
+		}
+	}
+	
+	return bound;
+}
+
+template <class Board>
+bool BasicKakuroConfig<Board>::diagnose(vector<pair<int, int>>& conflicts) const {
+	conflicts.clear();
+	if(m_board.empty()) return false;
+	
+	unsigned width = m_board.width();
+	
+	// Search from the fixed cells alone, with every propagator on so the lower bounds are as tight as they can be
+	shared_ptr<BasicKakuroConfig> root = make_shared<BasicKakuroConfig>(*this);
+	vector<pair<unsigned, int>> entries;
+	
+	for(unsigned index = 0; index < m_board.height() * width; ++index) {
+		const Cell& c = cellAt(index);
+		
+		if(c.isValueCell() && !c.isFixed() && c.value() != 0) {
+			entries.push_back(make_pair(index, c.value()));
+			root->unplace(index);
+		}
+	}
+	
+	// Setting the options propagates the cleared board under them
+	SearchOptions options = m_context->options();
+	options.propagateBounds = true;
+	options.propagateCombinations = true;
+	root->setSearchOptions(options);
+	
+	// Any solution disagrees with at most every entry, so a bound past that only fails when there's no solution at all
+	shared_ptr<BasicKakuroConfig> best;
+	if(leastConflicts(root, entries, entries.size() + 1, best) > int(entries.size())) return false;
+	
+	for(const pair<unsigned, int>& entry : entries) {
+		if(best->cellAt(entry.first).value() != entry.second) conflicts.push_back(make_pair(int(entry.first / width), int(entry.first % width)));
+	}
+	
+	return true;
 }
 
-void KakuroConfig::setParent(const shared_ptr<KakuroConfig>& parent) {
+template <class Board>
+void BasicKakuroConfig<Board>::setParent(const shared_ptr<BasicKakuroConfig<Board>>& parent) {
 	m_parent = parent;
 }
 
-shared_ptr<KakuroConfig> KakuroConfig::getParent() {
+template <class Board>
+shared_ptr<BasicKakuroConfig<Board>> BasicKakuroConfig<Board>::getParent() {
 	return m_parent;
 }
 
-vector<vector<Cell>> KakuroConfig::getBoard() const {
-	return m_board;
+template <class Board>
+int BasicKakuroConfig<Board>::deltaCell() const {
+	return m_deltaValue > 0 ? int(m_runs->index(m_deltaI, m_deltaJ)) : -1;
+}
+
+template <class Board>
+int BasicKakuroConfig<Board>::deltaValue() const {
+	return m_deltaValue;
 }
 
-ostream& operator<<(ostream& os, const KakuroConfig& c) {
-	for(unsigned i = 0; i < c.m_board.size(); ++i) {
-		for(unsigned j = 0; j < c.m_board[0].size(); ++j) {
+template <class Board>
+vector<vector<Cell>> BasicKakuroConfig<Board>::getBoard() const {
+	return m_board.toRows();
+}
+
+template <class Board>
+ostream& operator<<(ostream& os, const BasicKakuroConfig<Board>& c) {
+	for(unsigned i = 0; i < c.m_board.height(); ++i) {
+		for(unsigned j = 0; j < c.m_board.width(); ++j) {
 			if(c.m_shouldDelta && i == c.m_deltaI && j == c.m_deltaJ) {
-				os << "[" << c.m_board[i][j] << "]" << "\t";
+				os << "[" << c.m_board.at(i, j) << "]" << "\t";
 			} else {
-				os << c.m_board[i][j] << "\t";
+				os << c.m_board.at(i, j) << "\t";
 			}
 		}
 		
-		if(i != c.m_board.size() - 1) os << endl;
+		if(i != c.m_board.height() - 1) os << endl;
 	}
 	
 	return os;
 }
 
+// The board types configs are built with; withSizedConfig (in KakuroConfig.h) picks between them
+template class BasicKakuroConfig<TiledBoard>;
+template class BasicKakuroConfig<FixedBoard<9, 9>>;
+template class BasicKakuroConfig<FixedBoard<12, 12>>;
+template class BasicKakuroConfig<FixedBoard<16, 16>>;
+
+template ostream& operator<<(ostream& os, const BasicKakuroConfig<TiledBoard>& c);
+template ostream& operator<<(ostream& os, const BasicKakuroConfig<FixedBoard<9, 9>>& c);
+template ostream& operator<<(ostream& os, const BasicKakuroConfig<FixedBoard<12, 12>>& c);
+template ostream& operator<<(ostream& os, const BasicKakuroConfig<FixedBoard<16, 16>>& c);
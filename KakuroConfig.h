@@ -7,68 +7,317 @@
   * Description: This class represents a configuration of the Kakuro puzzle.
   *		 This configuration is used by the backtracking solver.
   *		 A configuration is either a goal or generates child configurations.
-  *		 The cell with the least possible values is picked to update for all successors.
+  *		 The cell picked to update for all successors is chosen by the search's cell ordering (see SearchContext.h).
 		 Only methods used by the backtracker and constructors are made public.
 		 No inheritance is used because the solver is templated.
+		 The config is templated on how it stores its board: KakuroConfig uses copy-on-write tiles for any size, and FixedKakuroConfig a fixed-size array.
+		 withSizedConfig picks the fixed-size type for the standard sizes and KakuroConfig for the rest.
   */
 
 #ifndef KAKURO_H
 #define KAKURO_H
 
 #include "Cell.h"
+#include "RunIndex.h"
+#include "FixedBoard.h"
+#include "SearchContext.h"
+#include "TiledBoard.h"
+#include "TiledVector.h"
 
+#include <cstdint>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
-class KakuroConfig {
+// Why a hinted value is forced, from the cheapest deduction to none at all
+enum class HintRule {
+	// The only value both of the cell's runs still allow
+	SingleCandidate,
+	
+	// A value every remaining combination of one of the cell's runs needs, and no other cell of the run can take
+	OnlyPlace,
+	
+	// Run bounds and combinations, followed through the board, leave the cell one value
+	Propagation,
+	
+	// Nothing is forced; the value is the cell's in a solution found by search
+	Search,
+	
+	// There's nothing to hint: the board is complete or can't be completed
+	None
+};
+
+// A value for an empty cell and the rule that forces it (row and col are -1 for HintRule::None)
+struct Hint {
+	int row, col, value;
+	HintRule rule;
+};
+
+inline std::string hintRuleName(HintRule rule) {
+	switch(rule) {
+		case HintRule::SingleCandidate: return "single candidate";
+		case HintRule::OnlyPlace: return "only place";
+		case HintRule::Propagation: return "propagation";
+		case HintRule::Search: return "search";
+		case HintRule::None: return "none";
+	}
+	
+	return "";
+}
+
+template <class Board>
+class BasicKakuroConfig {
+	private:
+		// Running totals of a run's cells, kept up to date as cells are filled
+		struct RunState {
+			// The sum still needed (meaningless for unrestricted runs)
+			int remaining;
+			
+			// The number of cells still unfilled
+			int unfilled;
+			
+			// How many cells hold each value, and how many of those are repeats
+			std::array<unsigned char, 9> counts;
+			int duplicates;
+			
+			// Which of the run's value combinations (Partitioner::subsets for its sum and length) are still feasible, one bit each
+			unsigned short alive;
+		};
+	
 	private:
 		unsigned m_deltaI, m_deltaJ;
-		bool m_isGoal;
 		bool m_shouldDelta;
 		
-		std::vector<std::vector<Cell>> m_board;
-		std::shared_ptr<KakuroConfig> m_parent;
+		// The value placed at the delta cell (0 if the config wasn't made by placing one)
+		int m_deltaValue;
+		
+		// The cells (see TiledBoard.h and FixedBoard.h)
+		Board m_board;
+		
+		// Structure and search state shared with every config derived from the same root
+		std::shared_ptr<const RunIndex> m_runs;
+		std::shared_ptr<SearchContext> m_context;
+		
+		// Per-run totals (shared with the parent until written, see TiledVector.h), the number of unfilled cells on the board, and the number of runs that can no longer be satisfied
+		TiledVector<RunState> m_runStates;
+		int m_unfilled;
+		int m_violations;
+		
+		// Whether propagation has proven the config can't be completed, and whether a cleared cell may have left possible values too narrow
+		bool m_contradiction;
+		bool m_stale;
+		
+		// Unfilled cells (by flat index) bucketed by their number of possible values, and each cell's position in its bucket (-1 if filled), shared like the run totals
+		std::array<TiledVector<unsigned>, 10> m_buckets;
+		TiledVector<int> m_bucketPos;
+		
+		// Random state for breaking ties, copied into successors
+		std::uint64_t m_rngState;
+		
+		std::shared_ptr<BasicKakuroConfig> m_parent;
 	
 	public:
 		// Constructor for the root config read in from a file
 		// shouldDelta is set to true for path mode to clarify what cell was updated at each step
-		KakuroConfig(std::vector<std::vector<Cell>> board, bool shouldDelta);
+		BasicKakuroConfig(std::vector<std::vector<Cell>> board, bool shouldDelta);
 		
 		// Constructor for creating a board from a filename
-		KakuroConfig(std::string filename);
+		BasicKakuroConfig(std::string filename);
 		
 		// Copy constructor used to generate successors
-		KakuroConfig(const KakuroConfig& other) = default;
+		BasicKakuroConfig(const BasicKakuroConfig& other) = default;
+	
+	public:
+		// Whether a complete board satisfies every run, checked in one pass over the cells
+		static bool isSolution(const std::vector<std::vector<Cell>>& board);
+		
+		// Reads a board in the text input format from a file (an empty board if the file is unusable)
+		static std::vector<std::vector<Cell>> readBoard(const std::string& filename);
+		
+		// Reads a board in the text input format from a stream (an empty board if the input is unusable)
+		static std::vector<std::vector<Cell>> readBoard(std::istream& input);
+		
+		// Writes a board in the text input format, so it reads back as the same board
+		static void writeBoard(std::ostream& os, const std::vector<std::vector<Cell>>& board);
 	
 	private:
-		// Whether or not the config is the goal config (re-calculates; fairly slow)
-		bool slowIsGoal() const;
+		// The cell at a flat index
+		const Cell& cellAt(unsigned index) const;
+		
+		// The cell at a flat index, to be changed (copying its tile first if the parent still shares it)
+		Cell& editCell(unsigned index);
+		
+		// Bucket maintenance; a cell must leave its bucket before its possible values change or it gets filled
+		void addToBucket(unsigned index);
+		void removeFromBucket(unsigned index);
+		
+		// Sets the possible values of an unfilled cell, moving it to the right bucket
+		void setDomain(unsigned index, std::array<bool, 9> values);
+		
+		// Whether a run has a repeated value or can no longer reach its sum
+		bool runViolated(int run) const;
+		
+		// Fills an unfilled cell, keeping its runs' totals and the goal tallies up to date
+		void place(unsigned index, int value);
+		
+		// Empties a filled cell, undoing what place did to its runs' totals and the goal tallies
+		// The cell is left out of the buckets until it's given possible values again
+		void unplace(unsigned index);
+		
+		// Recomputes the possible values of the unfilled cells sharing a run with the given cell from their runs' totals
+		// Unless widening, values already ruled out stay ruled out
+		void updatePeers(unsigned index, bool widen);
+		
+		// Recomputes every unfilled cell's possible values (and every run's combinations) from scratch and propagates them
+		void refreshDomains();
+		
+		// The sum still needed by a run, how many of its cells are unfilled, and which values it already uses
+		void runState(int run, int& remaining, int& unfilled, std::array<bool, 9>& used) const;
+		
+		// Narrows the domains (as bitmasks, one per run cell) of a run's unfilled cells to what its remaining sum allows given their peers' smallest and largest values
+		// Returns false if some cell is left without a possible value
+		bool boundRun(int run, std::vector<unsigned>& domains) const;
+		
+		// Prunes a run's combinations against its cells' domains (as bitmasks, one per run cell) and narrows the domains back to what the combinations allow
+		// Returns false if the run is left without a feasible combination or a value it needs has nowhere to go
+		bool combineRun(int run, std::vector<unsigned>& domains);
+		
+		// Applies the enabled run propagators until nothing changes, starting from the given runs
+		// Returns false if some run can't be satisfied any more
+		bool propagate(std::vector<int> pending);
+		
+		// The values a run still allows for its unfilled cells (all values if run is -1)
+		std::array<bool, 9> runPossibles(int run) const;
+		
+		// The number of unfilled cells sharing a run with the given cell
+		int unfilledPeers(unsigned index) const;
+		
+		// The summed failure weights of the cell's runs that still constrain another unfilled cell
+		unsigned weightedDegree(unsigned index) const;
+		
+		// Picks the cell to branch on according to the cell ordering, counting unfilled cells along the way
+		// Returns false if the config is a dead end (some unfilled cell has no possible values) or nothing is left to fill
+		bool selectCell(unsigned& ver, unsigned& hor, int& competitors);
+		
+		// The number of combinations left for a run's sum once an unfilled cell of it takes the given value
+		int combinationsWith(int run, int value) const;
+		
+		// The candidate values of a cell in the order the value ordering wants them tried
+		std::vector<int> orderValues(unsigned ver, unsigned hor, std::array<bool, 9> values);
+		
+		// A random number below n, drawn from the config's own random state
+		unsigned random(unsigned n);
+		
+		// Whether the newest of ties equally good candidates should replace the current pick (never unless ties are randomized)
+		bool breakTie(unsigned& ties);
+		
+		// The successors placing each of the values (in order) at a cell, leaving out those that break a run or fail to propagate
+		std::vector<std::shared_ptr<BasicKakuroConfig>> successorsAt(unsigned index, const std::vector<int>& values);
+		
+		// Of the player's entries (flat index and value), the ones a filled cell already disagrees with, and the unfilled ones this config branches on whose value is no longer possible
+		void countConflicts(const std::vector<std::pair<unsigned, int>>& entries, int& placed, int& forced) const;
+		
+		// Branch and bound for diagnose: the fewest entries any solution below a config disagrees with, and that solution, if it's fewer than bound (bound otherwise)
+		static int leastConflicts(const std::shared_ptr<BasicKakuroConfig>& config, const std::vector<std::pair<unsigned, int>>& entries, int bound, std::shared_ptr<BasicKakuroConfig>& best);
 		
 	public:
 		// Whether or not the config is the goal config (represents a solved puzzle)
 		bool isGoal() const;
 		
+		// Whether every run can still be satisfied (no repeats, each sum still reachable, and no contradiction found by propagation)
+		bool isConsistent() const;
+		
 		// The successors of the config, which are all possible values for the cell with the fewest possible values
-		std::vector<std::shared_ptr<KakuroConfig>> getSuccessors();
+		std::vector<std::shared_ptr<BasicKakuroConfig>> getSuccessors();
+		
+		// The successors getSuccessors would make if it picked the given cell (a flat index) and values, used to replay a checkpointed path
+		std::vector<std::shared_ptr<BasicKakuroConfig>> getSuccessors(unsigned index, const std::vector<int>& values);
+		
+		// Splits the config into one config per group of unfilled cells that share no run with any other group
+		// Each part only fills its own cells; returns nothing if there is just one group
+		std::vector<std::shared_ptr<BasicKakuroConfig>> splitComponents() const;
+		
+		// Fills in a config with the cells filled by the solutions of its parts
+		static std::shared_ptr<BasicKakuroConfig> mergeComponents(const BasicKakuroConfig& whole, const std::vector<std::shared_ptr<BasicKakuroConfig>>& parts);
+		
+		// Fills in a value cell (0 clears it), updating only its runs' totals and its peers' possible values
+		// Returns false if the cell isn't a value cell or was fixed on loading
+		bool setCell(unsigned row, unsigned col, int value);
+		
+		// Empties a value cell; the possible values propagation narrowed because of it are rebuilt on the next call to getSuccessors
+		// Returns false if the cell isn't a value cell or was fixed on loading
+		bool clearCell(unsigned row, unsigned col);
+		
+		// The cheapest deduction the board forces next, trying each rule in turn before falling back to search
+		// The board is solved first, so a board the player's entries have made unsolvable gets no hint (HintRule::None) rather than a wrong one
+		// Never changes the config, and never hints a value that isn't forced or part of a solution
+		Hint hint() const;
+		
+		// The fewest of the player's entries (filled cells that weren't fixed on loading) that have to be cleared for the board to be solvable again, as (row, column) pairs
+		// One search over the fixed cells finds the solution agreeing with the most entries; the conflicts are the entries it disagrees with, and none if the board is solvable as it is
+		// Returns false if the board can't be solved even with every entry cleared
+		bool diagnose(std::vector<std::pair<int, int>>& conflicts) const;
 		
 		// Sets the parent config of the config for path mode enumeration
-		void setParent(const std::shared_ptr<KakuroConfig>& parent);
+		void setParent(const std::shared_ptr<BasicKakuroConfig>& parent);
 		
 		// The parent config of the config
-		std::shared_ptr<KakuroConfig> getParent();
+		std::shared_ptr<BasicKakuroConfig> getParent();
+		
+		// Replaces the heuristic options (and any learned state) of the search rooted at this config, and propagates its possible values again under them
+		void setSearchOptions(const SearchOptions& options);
+		
+		// The heuristic options of the search this config belongs to
+		const SearchOptions& searchOptions() const;
+		
+		// Restarts the config's random state from the search's seed and an attempt number, so any attempt can be replayed
+		void reseed(unsigned attempt);
+		
+		// The config's random state, saved and restored by checkpoints
+		std::uint64_t randomState() const;
+		void setRandomState(std::uint64_t state);
+		
+		// The failure weights the search has learned per run, saved and restored by checkpoints
+		std::vector<unsigned> runWeights() const;
+		void setRunWeights(const std::vector<unsigned>& weights);
+		
+		// The cell (as a flat index, -1 if none) and value placed to make this config from its parent
+		int deltaCell() const;
+		int deltaValue() const;
 		
 		// The internal representation of the configuration's board
 		std::vector<std::vector<Cell>> getBoard() const;
 	
 	public:
 		// Output operator
-		friend std::ostream& operator<<(std::ostream& os, const KakuroConfig& c);
+		template <class B>
+		friend std::ostream& operator<<(std::ostream& os, const BasicKakuroConfig<B>& c);
 };
 
+// The config for boards of any size
+typedef BasicKakuroConfig<TiledBoard> KakuroConfig;
+
+// The config for boards of one size known at compile time
+template <unsigned Height, unsigned Width>
+using FixedKakuroConfig = BasicKakuroConfig<FixedBoard<Height, Width>>;
+
+// Calls visitor with a new config (as a shared pointer) for the board: a FixedKakuroConfig for 9x9, 12x12 and 16x16 boards, and a KakuroConfig otherwise
+// The visitor is a function object whose call operator is a template over the config type; whatever it returns is returned
+template <class Visitor>
+auto withSizedConfig(const std::vector<std::vector<Cell>>& board, bool shouldDelta, Visitor& visitor) -> decltype(visitor(std::shared_ptr<KakuroConfig>())) {
+	unsigned height = board.size(), width = board.empty() ? 0 : board[0].size();
+	
+	if(height == 9 && width == 9) return visitor(std::make_shared<FixedKakuroConfig<9, 9>>(board, shouldDelta));
+	if(height == 12 && width == 12) return visitor(std::make_shared<FixedKakuroConfig<12, 12>>(board, shouldDelta));
+	if(height == 16 && width == 16) return visitor(std::make_shared<FixedKakuroConfig<16, 16>>(board, shouldDelta));
+	
+	return visitor(std::make_shared<KakuroConfig>(board, shouldDelta));
+}
+
 #endif
 
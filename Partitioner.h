@@ -6,7 +6,8 @@
   *
   * Description: This class is a singleton that's primarily responsible for integer partitioning.
   * 		 Kakuro primarily relies on the ability to find a unique, arbitrary-length combination of numbers that sum to a given value.
-  *		 Through a naive recursive algorithm and caching, we achieve good partitioning performance.
+  *		 Every set of distinct digits is tabled by its sum and size once, on first use, and every question is answered from that table.
+  *		 The table never changes afterwards, so solvers on different threads share the instance without locking.
   */
 
 #ifndef KPART_H
@@ -14,19 +15,14 @@
 
 #include <algorithm>
 #include <array>
-#include <iostream>
-#include <string>
-#include <unordered_map>
 #include <vector>
 
 using namespace std;
 
 class Partitioner {
 	private:
-		int m_cacheHits;
-		int m_cacheMisses;
-		
-		unordered_map<string, array<bool, 9>> m_cache;
+		// Every set of distinct values as a bitmask (bit i for value i + 1), grouped by sum and size
+		array<array<vector<unsigned short>, 10>, 46> m_subsets;
 	
 	public:
 		// Singleton accessor for the partitioner class
@@ -37,7 +33,20 @@ class Partitioner {
 		
 	private:
 		// Default constructor (to be run once)
-		Partitioner() : m_cacheHits(0), m_cacheMisses(0), m_cache() {}
+		Partitioner() : m_subsets() {
+			for(unsigned mask = 1; mask < 512; ++mask) {
+				int sum(0), size(0);
+				
+				for(int i = 0; i < 9; ++i) {
+					if(mask & (1 << i)) {
+						sum += i + 1;
+						++size;
+					}
+				}
+				
+				m_subsets[sum][size].push_back(mask);
+			}
+		}
 		
 		// Disable copy construction
 		Partitioner(const Partitioner& other) = delete;
@@ -45,73 +54,35 @@ class Partitioner {
 		// Disable assignment
 		void operator=(const Partitioner& other) = delete;
 	
-		// Converts an array of 9 booleans to a readable string
-		string arrToStr(array<bool, 9> arr) {
-			string str;
-			
+	public:
+		// Converts a boolean array of values to a bitmask (bit i for value i + 1) and back
+		static unsigned toMask(const array<bool, 9>& values) {
+			unsigned mask(0);
 			for(int i = 0; i < 9; ++i) {
-				str.append(to_string(arr[i]) + " ");
+				if(values[i]) mask |= 1 << i;
 			}
 			
-			return str;
+			return mask;
 		}
 		
-		// Determines if a vector contains any contiguous duplicates
-		// Given the construction of the partitioning algorithm, duplicates will always be contiguous
-		bool isUnique(const vector<int>& vec) {
-			for(unsigned i = 1; i < vec.size(); ++i) {
-				if(vec[i] == vec[i - 1]) return false;
+		static array<bool, 9> fromMask(unsigned mask) {
+			array<bool, 9> values{};
+			for(int i = 0; i < 9; ++i) {
+				values[i] = (mask & (1 << i)) != 0;
 			}
 			
-			return true;
+			return values;
 		}
 		
-		// Determines if a vector contains a given number
-		bool vecContains(vector<int>& vec, int num) {
-			return find(vec.begin(), vec.end(), num) != vec.end();
-		}
-		
-		// Recursive algorithm to compute the integer partitions of a given number, sum
-		// The number is partitioned into num separate integers between minVal and maxVal
-		// All possible partitions are returned
-		vector<vector<int>> partHelper(int sum, int num, int minVal, int maxVal) {
-			vector<vector<int>> result;
-			
-			if(sum <= 1 || num == 1) {
-				if(sum >= minVal && sum <= maxVal) {
-					result.push_back(vector<int> {sum});
-					return result;
-				}
-			}
+		// Returns every set of length distinct values adding up to sum, as bitmasks
+		// The table holds all 511 nonempty sets, 502 of them with the two or more values a run needs, and no sum and size share more than 12
+		// It's built once and never changes, so it can be read from anywhere
+		const vector<unsigned short>& subsets(int sum, int length) const {
+			static const vector<unsigned short> none;
 			
-			int upperBound = (sum < maxVal) ? sum : maxVal;
-			
-			for(int i = upperBound; i >= minVal; --i) {
-				vector<vector<int>> recParts = partHelper(sum - i, num - 1, minVal, i);
-				for(vector<int>& recPart : recParts) {
-					recPart.push_back(i);
-					
-					int s1 = recPart.size();
-					
-					if(isUnique(recPart) && s1 == num) {
-						result.push_back(recPart);
-					}
-				}
-			}
+			if(sum < 0 || sum > 45 || length < 0 || length > 9) return none;
 			
-			return result;
-		}
-		
-		
-	public:
-		// Number of cache hits during partitioning requests
-		int cacheHits() const {
-			return m_cacheHits;
-		}
-		
-		// Number of cache misses during partitioning requests
-		int cacheMisses() const {
-			return m_cacheMisses;
+			return m_subsets[sum][length];
 		}
 		
 		// Returns the intersection of two boolean arrays
@@ -126,47 +97,34 @@ class Partitioner {
 		
 		// Returns the possible values of a cell in a cell group of size num which group needs to add up to sum
 		// Will not use any values marked in the used array
-		array<bool, 9> possibleValues(int sum, int num, array<bool, 9> used = array<bool, 9>()) {
-			string key = to_string(sum) + " " + to_string(num) + " " + arrToStr(used);
-			
-			if(m_cache.count(key) > 0) {
-				++m_cacheHits;
-				return m_cache[key];
-			}
-			
-			++m_cacheMisses;
+		array<bool, 9> possibleValues(int sum, int num, array<bool, 9> used = array<bool, 9>()) const {
+			unsigned usedMask = toMask(used);
 			
-			array<bool, 9> vals{};
+			// If the sum is less than or equal to 0, we have no restriction other than what's used
+			if(sum <= 0) return fromMask(0x1FF & ~usedMask);
 			
-			if(sum <= 0) {
-				// If the sum is less than or equal to 0, we have no restriction other than what's used
-				for(int i = 0; i < 9; ++i) vals[i] = !used[i];
-				return vals;
+			unsigned vals(0);
+			for(unsigned short subset : subsets(sum, num)) {
+				if(!(subset & usedMask)) vals |= subset;
 			}
 			
-			vector<vector<int>> parts = partHelper(sum, num, 1, 9);
+			return fromMask(vals);
+		}
+		
+		// Returns the number of combinations of num distinct digits adding up to sum, not using any values marked in the used array
+		// Unlike possibleValues, a sum of 0 or less is not treated as unrestricted
+		int numCombinations(int sum, int num, array<bool, 9> used = array<bool, 9>()) const {
+			// The table leaves out the empty set, the one way of picking no digits
+			if(num == 0) return sum == 0 ? 1 : 0;
 			
-			for(auto& v : parts) {
-				bool cont = true;
-				array<bool, 9> tmp{};
-				for(int val : v) {
-					if(used[val - 1]) {
-						cont = false;
-						break;
-					}
-					tmp[val - 1] = true;
-				}
-				
-				if(cont) {
-					for(int i = 0; i < 9; ++i) {
-						vals[i] |= tmp[i];
-					}
-				}
-			}
+			unsigned usedMask = toMask(used);
+			int count(0);
 			
-			m_cache[key] = vals;
+			for(unsigned short subset : subsets(sum, num)) {
+				if(!(subset & usedMask)) ++count;
+			}
 			
-			return vals;
+			return count;
 		}
 };
 
@@ -0,0 +1,233 @@
+/**
+  * Portfolio.h
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This is a solver that races several differently configured searches of the same puzzle, one thread each.
+  *		 Each entry of the portfolio gives its copy of the root config its own search options (orderings, propagation, seed) and restart schedule.
+  *		 The first search to settle the puzzle (solving it, or proving it has no solution) wins and cancels the rest.
+  *		 A progress callback in the limits hears from whichever search is furthest along, one call at a time.
+  *		 Like Solver, it's solved during construction; the winner's entry and solution path, and every search's own result, can be read back afterwards.
+  */
+
+#ifndef KPORTFOLIO_H
+#define KPORTFOLIO_H
+
+#include "SearchContext.h"
+#include "Solver.h"
+#include "SolverStats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// One search of a portfolio
+struct PortfolioEntry {
+	SearchOptions options;
+	RestartSchedule schedule;
+	
+	// A short description of the entry, for reports
+	string name() const {
+		string name = cellOrderingName(options.cellOrdering) + "/" + valueOrderingName(options.valueOrdering);
+		
+		if(!options.propagateBounds) name += "/no-bounds";
+		if(!options.propagateCombinations) name += "/no-combinations";
+		if(options.randomTies) name += "/seed-" + to_string(options.seed);
+		if(schedule.policy == RestartPolicy::Luby) name += "/luby";
+		if(schedule.policy == RestartPolicy::Geometric) name += "/geometric";
+		
+		return name;
+	}
+};
+
+// The default portfolio of a given size (one entry per core if size is 0), varying the base options
+// The deterministic orderings come first; past those, entries break ties at random with their own seed and restart on the Luby schedule
+inline vector<PortfolioEntry> defaultPortfolio(unsigned size, const SearchOptions& base = SearchOptions()) {
+	if(size == 0) size = max(1u, thread::hardware_concurrency());
+	
+	vector<PortfolioEntry> entries;
+	
+	const CellOrdering cellOrderings[] = {CellOrdering::MinRemainingDegree, CellOrdering::DomWDeg, CellOrdering::TightestRun, CellOrdering::FirstFewest};
+	const ValueOrdering valueOrderings[] = {ValueOrdering::Ascending, ValueOrdering::LeastConstraining};
+	
+	for(ValueOrdering values : valueOrderings) {
+		for(CellOrdering cells : cellOrderings) {
+			if(entries.size() == size) return entries;
+			
+			PortfolioEntry entry;
+			entry.options = base;
+			entry.options.cellOrdering = cells;
+			entry.options.valueOrdering = values;
+			
+			entries.push_back(entry);
+		}
+	}
+	
+	for(unsigned seed = 1; entries.size() < size; ++seed) {
+		PortfolioEntry entry;
+		entry.options = base;
+		entry.options.cellOrdering = cellOrderings[seed % 2];
+		entry.options.randomTies = true;
+		entry.options.seed = seed;
+		entry.schedule.policy = RestartPolicy::Luby;
+		
+		entries.push_back(entry);
+	}
+	
+	return entries;
+}
+
+template <class T, class Stats = CountingStats>
+class PortfolioSolver {
+	private:
+		vector<PortfolioEntry> m_entries;
+		
+		// Each entry's search, once it has stopped
+		vector<unique_ptr<Solver<T, Stats>>> m_solvers;
+		
+		// The entry that settled the puzzle (-1 if none did)
+		int m_winner;
+		
+		SolveStatus m_status;
+		double m_elapsedMs;
+	
+	public:
+		// Limits apply to every search alone; raising the cancellation flag stops them all
+		PortfolioSolver(shared_ptr<T> initialConfig, const vector<PortfolioEntry>& entries, const SolverLimits& limits = SolverLimits()) :
+			m_entries(entries), m_solvers(entries.size()), m_winner(-1), m_status(SolveStatus::BudgetExceeded), m_elapsedMs(0) {
+			auto start = chrono::steady_clock::now();
+			
+			// The searches answer to their own flag, so a winner can stop its rivals without raising the caller's
+			SolverLimits shared = limits;
+			shared.cancelled = make_shared<atomic<bool>>(false);
+			
+			// Racing searches can't share one checkpoint file
+			shared.checkpointFile.clear();
+			
+			atomic<int> winner(-1);
+			mutex doneMutex;
+			condition_variable done;
+			unsigned finished(0);
+			
+			// The fraction each search has covered, so only the leader's progress is passed on
+			vector<double> covered(m_entries.size(), 0);
+			mutex progressMutex;
+			
+			vector<thread> threads;
+			
+			for(unsigned k = 0; k < m_entries.size(); ++k) {
+				// Each search gets its own root, so its options and learned weights are its own
+				shared_ptr<T> root = make_shared<T>(*initialConfig);
+				root->setSearchOptions(m_entries[k].options);
+				
+				SolverLimits own = shared;
+				
+				if(limits.progress) {
+					ProgressCallback forward = limits.progress;
+					
+					own.progress = [k, forward, &covered, &progressMutex](const SolveProgress& progress) {
+						lock_guard<mutex> lock(progressMutex);
+						covered[k] = progress.fraction;
+						
+						if(progress.fraction >= *max_element(covered.begin(), covered.end())) forward(progress);
+					};
+				}
+				
+				threads.push_back(thread([this, k, root, own, &shared, &winner, &doneMutex, &done, &finished]() {
+					m_solvers[k].reset(new Solver<T, Stats>(root, own, m_entries[k].schedule));
+					
+					SolveStatus status = m_solvers[k]->status();
+					int none(-1);
+					
+					if((status == SolveStatus::Solved || status == SolveStatus::Unsolvable) && winner.compare_exchange_strong(none, int(k))) {
+						shared.cancelled->store(true);
+					}
+					
+					{
+						lock_guard<mutex> lock(doneMutex);
+						++finished;
+					}
+					
+					done.notify_one();
+				}));
+			}
+			
+			// Pass the caller's cancellation on to the searches while waiting for them
+			{
+				unique_lock<mutex> lock(doneMutex);
+				
+				while(finished < m_entries.size()) {
+					done.wait_for(lock, chrono::milliseconds(5));
+					
+					if(limits.cancelled && limits.cancelled->load()) shared.cancelled->store(true);
+				}
+			}
+			
+			for(thread& t : threads) t.join();
+			
+			m_winner = winner.load();
+			
+			if(m_winner != -1) {
+				m_status = m_solvers[m_winner]->status();
+			} else if(limits.cancelled && limits.cancelled->load()) {
+				m_status = SolveStatus::Cancelled;
+			}
+			
+			m_elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+		}
+	
+	public:
+		bool isFailure() const {
+			return m_status != SolveStatus::Solved;
+		}
+		
+		// How the race ended: the winner's status, or why nobody won
+		SolveStatus status() const {
+			return m_status;
+		}
+		
+		// The index of the winning entry (-1 if no search settled the puzzle)
+		int winner() const {
+			return m_winner;
+		}
+		
+		const vector<PortfolioEntry>& entries() const {
+			return m_entries;
+		}
+		
+		// An entry's search, as it stood when it stopped
+		const Solver<T, Stats>& solver(unsigned k) const {
+			return *m_solvers[k];
+		}
+		
+		// Nodes visited by every search together
+		long totalNodes() const {
+			long total(0);
+			for(const unique_ptr<Solver<T, Stats>>& solver : m_solvers) total += solver->numNodes();
+			
+			return total;
+		}
+		
+		// Wall-clock time of the race
+		double elapsedMs() const {
+			return m_elapsedMs;
+		}
+		
+		// The winner's solution path (empty if nobody solved the puzzle)
+		const vector<shared_ptr<T>>& getSolutionPath() const {
+			static const vector<shared_ptr<T>> none;
+			
+			return m_winner != -1 ? m_solvers[m_winner]->getSolutionPath() : none;
+		}
+};
+
+#endif
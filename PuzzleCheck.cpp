@@ -0,0 +1,169 @@
+/**
+  * PuzzleCheck.cpp
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This is an implementation of PuzzleCheck.h.
+  * 		 For an explanation of the functions, please consult that file.
+  */
+
+#include "Cell.h"
+#include "Partitioner.h"
+#include "PuzzleCheck.h"
+#include "RunIndex.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// The digits of a mask (bit i for value i + 1) as a list for messages, e.g. "3, 5 and 9"
+static string listDigits(unsigned mask) {
+	vector<string> digits;
+	for(int i = 0; i < 9; ++i) {
+		if(mask & (1 << i)) digits.push_back(to_string(i + 1));
+	}
+	
+	string list;
+	
+	for(unsigned k = 0; k < digits.size(); ++k) {
+		if(k > 0) list += (k + 1 == digits.size()) ? " and " : ", ";
+		list += digits[k];
+	}
+	
+	return list;
+}
+
+vector<PuzzleProblem> checkPuzzle(const vector<vector<Cell>>& board) {
+	vector<PuzzleProblem> problems;
+	
+	if(board.empty() || board[0].empty()) {
+		problems.push_back(PuzzleProblem{-1, -1, "The board is empty or couldn't be read."});
+		return problems;
+	}
+	
+	unsigned height = board.size(), width = board[0].size();
+	
+	for(unsigned i = 0; i < height; ++i) {
+		if(board[i].size() != width) {
+			problems.push_back(PuzzleProblem{int(i), -1, "The row has " + to_string(board[i].size()) + " cells where the first has " + to_string(width) + "."});
+			return problems;
+		}
+	}
+	
+	// PASS 1:
+	// Cells on their own: givens must be digits, and a sum needs a run to add up
+	for(unsigned i = 0; i < height; ++i) {
+		for(unsigned j = 0; j < width; ++j) {
+			const Cell& c = board[i][j];
+			
+			if(c.isValueCell()) {
+				if(c.value() < 0 || c.value() > 9) problems.push_back(PuzzleProblem{int(i), int(j), "The given " + to_string(c.value()) + " isn't a digit."});
+				continue;
+			}
+			
+			if(c.rightSum() != 0 && (j + 1 >= width || !board[i][j + 1].isValueCell())) {
+				problems.push_back(PuzzleProblem{int(i), int(j), "The right sum " + to_string(c.rightSum()) + " has no run after it."});
+			}
+			
+			if(c.downSum() != 0 && (i + 1 >= height || !board[i + 1][j].isValueCell())) {
+				problems.push_back(PuzzleProblem{int(i), int(j), "The down sum " + to_string(c.downSum()) + " has no run below it."});
+			}
+		}
+	}
+	
+	// PASS 2:
+	// Each run: its length, its sum against that length, and its givens against its sum
+	RunIndex runs(board);
+	
+	// The digits each empty cell's runs allow it, and whether a run already has a problem of its own
+	vector<unsigned> allowed(height * width, 0x1FF);
+	vector<bool> broken(runs.runs().size(), false);
+	
+	for(unsigned r = 0; r < runs.runs().size(); ++r) {
+		const Run& run = runs.runs()[r];
+		
+		unsigned first = run.cells.front();
+		unsigned sumIndex = run.horizontal ? first - 1 : first - width;
+		int row = sumIndex / width, col = sumIndex % width;
+		
+		string name = run.horizontal ? "right" : "down";
+		int length = run.cells.size();
+		
+		if(length > 9) {
+			problems.push_back(PuzzleProblem{row, col, "The " + name + " run has " + to_string(length) + " cells, more than there are distinct digits."});
+			broken[r] = true;
+			continue;
+		}
+		
+		unsigned used(0), repeated(0);
+		
+		for(unsigned index : run.cells) {
+			int value = board[index / width][index % width].value();
+			if(value < 1 || value > 9) continue;
+			
+			if(used & (1 << (value - 1))) repeated |= 1 << (value - 1);
+			used |= 1 << (value - 1);
+		}
+		
+		if(repeated != 0) {
+			problems.push_back(PuzzleProblem{row, col, "The " + name + " run repeats the given " + listDigits(repeated) + "."});
+			broken[r] = true;
+			continue;
+		}
+		
+		unsigned runAllowed = 0x1FF & ~used;
+		
+		if(run.sum != 0) {
+			// n distinct digits add up to anywhere from 1 + ... + n to 9 + ... + (10 - n)
+			int low = length * (length + 1) / 2, high = length * (19 - length) / 2;
+			
+			if(run.sum < low || run.sum > high) {
+				problems.push_back(PuzzleProblem{row, col, "The " + name + " sum " + to_string(run.sum) + " can't be made by " + to_string(length) + " distinct digits, which add up to " + to_string(low) + " to " + to_string(high) + "."});
+				broken[r] = true;
+				continue;
+			}
+			
+			unsigned combined(0);
+			for(unsigned short subset : Partitioner::getInstance().subsets(run.sum, length)) {
+				if((subset & used) == used) combined |= subset;
+			}
+			
+			if(combined == 0) {
+				problems.push_back(PuzzleProblem{row, col, "No " + to_string(length) + " distinct digits adding up to the " + name + " sum " + to_string(run.sum) + " include the given " + listDigits(used) + "."});
+				broken[r] = true;
+				continue;
+			}
+			
+			runAllowed &= combined;
+		}
+		
+		for(unsigned index : run.cells) {
+			if(board[index / width][index % width].value() == 0) allowed[index] &= runAllowed;
+		}
+	}
+	
+	// PASS 3:
+	// Where two sound runs cross at an empty cell, some digit must suit both
+	for(unsigned index = 0; index < height * width; ++index) {
+		if(allowed[index] != 0) continue;
+		
+		int hor = runs.horizontalRun(index), ver = runs.verticalRun(index);
+		if((hor != -1 && broken[hor]) || (ver != -1 && broken[ver])) continue;
+		
+		problems.push_back(PuzzleProblem{int(index / width), int(index % width), "No digit fits both the right and down runs through the cell."});
+	}
+	
+	stable_sort(problems.begin(), problems.end(), [](const PuzzleProblem& a, const PuzzleProblem& b) { return a.row != b.row ? a.row < b.row : a.col < b.col; });
+	
+	return problems;
+}
+
+string describeProblem(const PuzzleProblem& problem) {
+	if(problem.row < 0) return problem.message;
+	if(problem.col < 0) return "Row " + to_string(problem.row + 1) + ": " + problem.message;
+	
+	return "Row " + to_string(problem.row + 1) + ", column " + to_string(problem.col + 1) + ": " + problem.message;
+}
@@ -0,0 +1,36 @@
+/**
+  * PuzzleCheck.h
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: These functions look a puzzle's clues over for problems that leave it no solution, before any search is spent on it.
+  *		 Givens must be digits, every sum needs a run after it and must be reachable by that many distinct digits, runs can be no longer than 9 cells, and a run's givens must fit its sum.
+  *		 Every empty cell must also have some digit both of its runs allow.
+  *		 Only the board's runs and the partitioner's table of value combinations are needed, so even large boards are checked in microseconds.
+  *		 A puzzle failing any check can never be solved; one passing them all still might not be.
+  */
+
+#ifndef KCHECK_H
+#define KCHECK_H
+
+#include "Cell.h"
+
+#include <string>
+#include <vector>
+
+struct PuzzleProblem {
+	// The cell the problem was found at (the sum cell for a run's problems), or -1 for the board as a whole
+	int row, col;
+	
+	// What's wrong, as a sentence leaving out where
+	std::string message;
+};
+
+// Every problem found with a board, in board order (none if it passes)
+std::vector<PuzzleProblem> checkPuzzle(const std::vector<std::vector<Cell>>& board);
+
+// A problem with its location, for showing to people
+std::string describeProblem(const PuzzleProblem& problem);
+
+#endif
@@ -8,50 +8,43 @@
   * 		 For an explanation of the class, please consult that file.
   */
 
+#include "BoardView.h"
 #include "Cell.h"
 #include "KakuroConfig.h"
+#include "PuzzleCheck.h"
 #include "PuzzleWindow.h"
 #include "Solver.h"
 
 #include <iostream>
 
-#include <QApplication>
-#include <QComboBox>
+#include <QCoreApplication>
 #include <QFileDialog>
-#include <QGridLayout>
 #include <QGroupBox>
 #include <QHBoxLayout>
-#include <QLabel>
 #include <QMessageBox>
+#include <QProgressDialog>
 #include <QPushButton>
 #include <QSizePolicy>
-#include <QStringListModel>
 #include <QVBoxLayout>
 #include <QWidget>
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace std;
 
-PuzzleWindow::PuzzleWindow() : comboModel(new QStringListModel(this)) {
+PuzzleWindow::PuzzleWindow() {
 	// Set up main layout
 	mainLayout = new QVBoxLayout;
 	
 	this->setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Minimum);
 	
-	// Set up the combobox model
-	comboList = new QStringList;
-	*comboList << QString("-");
-	for(int i = 1; i <= 9; ++i) {
-		*comboList << QString(to_string(i).c_str());
-	}
-	
-	comboModel->setStringList(*comboList);
-	
 	// Set up a horizontal layout for the buttons
 	buttonBox = new QGroupBox;
 	
@@ -81,12 +74,16 @@ PuzzleWindow::PuzzleWindow() : comboModel(new QStringListModel(this)) {
 	
 	buttonBox->setLayout(buttonLayout);
 	
-	// Initialize the grid
+	// Initialize the board
 	gridBox = new QGroupBox;
 	
-	gridLayout = new QGridLayout;
+	boardView = new BoardView;
+	connect(boardView, SIGNAL(cellEdited(int, int, int)), this, SLOT(cellEditedSlot(int, int, int)));
+	
+	QVBoxLayout* boardLayout = new QVBoxLayout;
+	boardLayout->addWidget(boardView);
 	
-	gridBox->setLayout(gridLayout);
+	gridBox->setLayout(boardLayout);
 	
 	// Add everything to the main layout
 	mainLayout->addWidget(buttonBox);
@@ -98,65 +95,10 @@ PuzzleWindow::PuzzleWindow() : comboModel(new QStringListModel(this)) {
 }
 
 void PuzzleWindow::displayKakuroConfig(const KakuroConfig& c) {
-	while(gridLayout->count() > 0) {
-		QWidget* widget = gridLayout->itemAt(0)->widget();
-		gridLayout->removeWidget(widget);
-		delete widget;
+	// The view repaints just the cells that changed; the window only needs refitting when the board's shape does
+	if(boardView->setBoard(c.getBoard())) {
+		this->resize(0, 0);
 	}
-	
-	delete gridLayout;
-	gridLayout = new QGridLayout;
-	gridBox->setLayout(gridLayout);
-	
-	vector<vector<Cell>> board = c.getBoard();
-	for(unsigned int i = 0; i < board.size(); ++i) {
-		for(unsigned int j = 0; j < board.at(0).size(); ++j) {
-			Cell& c = board.at(i).at(j);
-			
-			if(c.isValueCell()) {
-				QComboBox* combo = new QComboBox;
-				combo->setModel(comboModel);
-				combo->setCurrentIndex(c.value());
-				
-				if(c.isFixed()) {
-					combo->setEnabled(false);
-				}
-				
-				connect(combo, SIGNAL(currentIndexChanged(int)), this, SLOT(comboBoxUpdatedSlot()));
-				gridLayout->addWidget(combo, i, j);
-			} else {
-				ostringstream oss;
-				oss << c;
-				gridLayout->addWidget(new QLabel(QString(oss.str().c_str())), i, j);
-			}
-		}
-	}
-	
-	QApplication::processEvents();
-	
-	this->resize(0, 0);
-}
-
-KakuroConfig PuzzleWindow::configFromDisplay() {
-	vector<vector<Cell>> currentBoard = currentConfig->getBoard();	
-	int cols = currentBoard.size();
-	int rows = currentBoard.at(0).size();
-	
-	vector<vector<Cell>> newBoard(cols, vector<Cell>());
-	
-	for(int i = 0; i < cols; ++i) {
-		for(int j = 0; j < rows; ++j) {
-			if(currentBoard.at(i).at(j).isValueCell()) {
-				QComboBox* combo = (QComboBox*)(gridLayout->itemAtPosition(i, j)->widget());
-				int gridVal = combo->currentIndex();
-				newBoard.at(i).push_back(Cell(gridVal, !combo->isEnabled()));
-			} else {
-				newBoard.at(i).push_back(currentBoard.at(i).at(j));
-			}
-		}
-	}
-	
-	return KakuroConfig(newBoard, false);
 }
 
 void PuzzleWindow::loadSlot() {
@@ -172,7 +114,20 @@ void PuzzleWindow::loadSlot() {
 	
 	file.close();
 	
-	currentConfig = make_shared<KakuroConfig>(filename);
+	// Puzzles whose clues can't add up are turned away before they're ever searched
+	vector<vector<Cell>> board = KakuroConfig::readBoard(filename);
+	vector<PuzzleProblem> problems = checkPuzzle(board);
+	
+	if(!problems.empty()) {
+		QString details;
+		for(unsigned k = 0; k < problems.size() && k < 10; ++k) details += QString::fromStdString(describeProblem(problems[k])) + "\n";
+		if(problems.size() > 10) details += QString("...and %1 more.").arg(int(problems.size() - 10));
+		
+		QMessageBox::warning(this, "Invalid puzzle", "The puzzle can't be solved:\n\n" + details);
+		return;
+	}
+	
+	currentConfig = make_shared<KakuroConfig>(board, false);
 	
 	initialConfig = make_shared<KakuroConfig>(*currentConfig);
 	
@@ -187,8 +142,21 @@ void PuzzleWindow::checkSlot() {
 	Solver<KakuroConfig> solver(currentConfig);
 	
 	if(solver.isFailure()) {
-		QMessageBox::information(this, "Solvable?", "The puzzle is not solvable from its current state.");
+		// One more search finds the fewest entries standing in the way, rather than solving again without each entry in turn
+		vector<pair<int, int>> conflicts;
+		
+		if(!currentConfig->diagnose(conflicts)) {
+			QMessageBox::information(this, "Solvable?", "The puzzle is not solvable, even with all of your entries cleared.");
+			return;
+		}
+		
+		boardView->setConflicts(conflicts);
+		
+		QString entries = (conflicts.size() == 1) ? QString("entry") : QString("%1 entries").arg(int(conflicts.size()));
+		QMessageBox::information(this, "Solvable?", "The puzzle is not solvable from its current state. Clearing the highlighted " + entries + " (the fewest that will do) makes it solvable again.");
 	} else {
+		boardView->setConflicts(vector<pair<int, int>>());
+		
 		if(currentConfig->isGoal()) {
 			QMessageBox::information(this, "Solvable?", "The puzzle is solved!");
 		} else {
@@ -202,24 +170,33 @@ void PuzzleWindow::hintSlot() {
 		return;
 	}
 	
-	Solver<KakuroConfig> solver(currentConfig);
+	if(currentConfig->isGoal()) {
+		QMessageBox::information(this, "Invalid", "No hints available; you already won!");
+		return;
+	}
 	
-	if(solver.isFailure()) {
+	// Only falls back to solving the puzzle when nothing is forced
+	Hint hint = currentConfig->hint();
+	
+	if(hint.rule == HintRule::None) {
 		QMessageBox::information(this, "Invalid", "The current puzzle cannot reach a solution. Why not try another approach?");
-	} else {
-		vector<shared_ptr<KakuroConfig>> path = solver.getSolutionPath();
-		
-		if(path.size() == 1) {
-			QMessageBox::information(this, "Invalid", "No hints available; you already won!");
-			return;
-		}
-		
-		currentConfig = path.at(path.size() - 2);
-		
-		currentConfig->setParent(nullptr);
-		
-		displayKakuroConfig(*currentConfig);
+		return;
+	}
+	
+	currentConfig->setCell(hint.row, hint.col, hint.value);
+	displayKakuroConfig(*currentConfig);
+	
+	QString cell = QString("Row %1, column %2 must be %3").arg(hint.row + 1).arg(hint.col + 1).arg(hint.value);
+	QString reason;
+	
+	switch(hint.rule) {
+		case HintRule::SingleCandidate: reason = "it's the only value both of its runs allow."; break;
+		case HintRule::OnlyPlace: reason = "one of its runs needs that value and it's the only cell that can take it."; break;
+		case HintRule::Propagation: reason = "the runs' sums, followed through the board, leave it no other value."; break;
+		default: reason = "nothing is forced yet, so this is the value it has in a solution."; break;
 	}
+	
+	QMessageBox::information(this, "Hint", cell + ": " + reason);
 }
 
 void PuzzleWindow::solveSlot() {
@@ -227,7 +204,33 @@ void PuzzleWindow::solveSlot() {
 		return;
 	}
 	
-	Solver<KakuroConfig> solver(currentConfig);
+	// Long solves show how far along they seem to be, and can be cancelled
+	QProgressDialog progressDialog("Solving...", "Cancel", 0, 1000, this);
+	progressDialog.setWindowModality(Qt::WindowModal);
+	progressDialog.setMinimumDuration(500);
+	
+	shared_ptr<atomic<bool>> cancelled = make_shared<atomic<bool>>(false);
+	
+	SolverLimits limits;
+	limits.cancelled = cancelled;
+	limits.progressNodes = 1024;
+	limits.progress = [&progressDialog, cancelled](const SolveProgress& progress) {
+		// The estimate can fall short, so the bar stops short of full until the solve ends
+		progressDialog.setValue(int(1000 * min(progress.fraction, 0.999)));
+		
+		QString remaining = progress.remainingMs >= 0 ? QString("about %1 s left").arg(progress.remainingMs / 1000, 0, 'f', 1) : QString("estimating time left");
+		progressDialog.setLabelText(QString("Solving: %1 nodes of about %2, %3").arg(progress.nodes).arg(progress.estimatedNodes, 0, 'g', 3).arg(remaining));
+		
+		QCoreApplication::processEvents();
+		if(progressDialog.wasCanceled()) cancelled->store(true);
+	};
+	
+	Solver<KakuroConfig> solver(currentConfig, limits);
+	progressDialog.setValue(1000);
+	
+	if(solver.status() == SolveStatus::Cancelled) {
+		return;
+	}
 	
 	if(solver.isFailure()) {
 		QMessageBox::information(this, "Invalid", "The current puzzle cannot reach a solution. Why not try another approach, or reset and click solve again?");
@@ -262,7 +265,12 @@ Good luck!)raw";
 	QMessageBox::information(this, "Help", QString(helpString.c_str()));
 }
 
-void PuzzleWindow::comboBoxUpdatedSlot() {
-	currentConfig = make_shared<KakuroConfig>(configFromDisplay());
+void PuzzleWindow::cellEditedSlot(int row, int col, int value) {
+	if(currentConfig == nullptr) {
+		return;
+	}
+	
+	// Only the edited cell's runs need updating
+	currentConfig->setCell(row, col, value);
 }
 
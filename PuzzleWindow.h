@@ -5,19 +5,18 @@
   * Date: May 11th, 2014
   *
   * Description: This class represents the main and solve window of the Kakuro puzzle game.
-  * 		 It contains UI elements to represent an interactive game board.
-  *		 It also contains utility functions for converting UI to config models and vice-versa.
+  * 		 It contains UI elements to represent an interactive game board (see BoardView.h).
+  *		 Cells the player edits are updated in the current config in place rather than rebuilding it from the display.
   */
 
 #ifndef PUZZLE_H
 #define PUZZLE_H
 
+#include "BoardView.h"
 #include "KakuroConfig.h"
 
-#include <QGridLayout>
 #include <QGroupBox>
 #include <QPushButton>
-#include <QStringListModel>
 #include <QVBoxLayout>
 #include <QWidget>
 
@@ -27,10 +26,6 @@ class PuzzleWindow : public QWidget {
 	Q_OBJECT
 	
 	private:
-		// String model information for comboboxes
-		QStringListModel* comboModel;
-		QStringList* comboList;
-		
 		// The window's main layout
 		QVBoxLayout* mainLayout;
 		
@@ -38,8 +33,8 @@ class PuzzleWindow : public QWidget {
 		QGroupBox* buttonBox;
 		QGroupBox* gridBox;
 		
-		// Grid for the game's comboboxes
-		QGridLayout* gridLayout;
+		// The game board
+		BoardView* boardView;
 		
 		// All the window's buttons
 		QPushButton* loadButton;
@@ -55,9 +50,8 @@ class PuzzleWindow : public QWidget {
 		std::shared_ptr<KakuroConfig> currentConfig;
 	
 	private:
-		// Functions to convert between view/controller and model game boards
+		// Shows a config's board; edits go straight to the current config (see cellEditedSlot)
 		void displayKakuroConfig(const KakuroConfig& c);
-		KakuroConfig configFromDisplay();
 	
 	private slots:
 		// Slots to hook into the buttons
@@ -68,8 +62,8 @@ class PuzzleWindow : public QWidget {
 		void resetSlot();
 		void helpSlot();
 		
-		// A slot for combo box updating
-		void comboBoxUpdatedSlot();
+		// A slot for the player filling in a cell
+		void cellEditedSlot(int row, int col, int value);
 		
 	public:
 		// Our simple yet effective constructor
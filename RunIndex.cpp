@@ -0,0 +1,74 @@
+/**
+  * RunIndex.cpp
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This is an implementation of RunIndex.h.
+  * 		 For an explanation of the class, please consult that file.
+  */
+
+#include "RunIndex.h"
+
+#include <vector>
+
+using namespace std;
+
+RunIndex::RunIndex(const vector<vector<Cell>>& board) : 
+	m_height(board.size()), m_width(board.empty() ? 0 : board[0].size()), m_runs(), 
+	m_horRun(m_height * m_width, -1), m_verRun(m_height * m_width, -1) {
+	for(unsigned i = 0; i < m_height; ++i) {
+		for(unsigned j = 0; j < m_width; ++j) {
+			const Cell& c = board[i][j];
+			
+			if(c.isValueCell()) continue;
+			
+			// Walk right, then down, collecting the value cells governed by this sum cell
+			if(j + 1 < m_width && board[i][j + 1].isValueCell()) {
+				Run run{c.rightSum(), true, vector<unsigned>()};
+				
+				for(unsigned k = j + 1; k < m_width && board[i][k].isValueCell(); ++k) {
+					run.cells.push_back(index(i, k));
+					m_horRun[index(i, k)] = m_runs.size();
+				}
+				
+				m_runs.push_back(run);
+			}
+			
+			if(i + 1 < m_height && board[i + 1][j].isValueCell()) {
+				Run run{c.downSum(), false, vector<unsigned>()};
+				
+				for(unsigned k = i + 1; k < m_height && board[k][j].isValueCell(); ++k) {
+					run.cells.push_back(index(k, j));
+					m_verRun[index(k, j)] = m_runs.size();
+				}
+				
+				m_runs.push_back(run);
+			}
+		}
+	}
+}
+
+unsigned RunIndex::height() const {
+	return m_height;
+}
+
+unsigned RunIndex::width() const {
+	return m_width;
+}
+
+unsigned RunIndex::index(unsigned i, unsigned j) const {
+	return i * m_width + j;
+}
+
+const vector<Run>& RunIndex::runs() const {
+	return m_runs;
+}
+
+int RunIndex::horizontalRun(unsigned index) const {
+	return m_horRun[index];
+}
+
+int RunIndex::verticalRun(unsigned index) const {
+	return m_verRun[index];
+}
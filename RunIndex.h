@@ -0,0 +1,59 @@
+/**
+  * RunIndex.h
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This class describes the fixed structure of a Kakuro board: its runs.
+  *		 A run is a maximal line of value cells to the right of or below a sum cell, and its cells must add up to that sum.
+  *		 The structure never changes during a search, so a single index is built from the root board and shared by every config.
+  */
+
+#ifndef KRUNS_H
+#define KRUNS_H
+
+#include "Cell.h"
+
+#include <vector>
+
+struct Run {
+	// The sum constraint of the run (0 means no restriction)
+	int sum;
+	
+	// Whether the run goes to the right of its sum cell (as opposed to below it)
+	bool horizontal;
+	
+	// The flat indices (row * width + column) of the run's value cells, in board order
+	std::vector<unsigned> cells;
+};
+
+class RunIndex {
+	private:
+		unsigned m_height, m_width;
+		
+		std::vector<Run> m_runs;
+		
+		// Per flat cell index, the horizontal and vertical run containing it (-1 for none)
+		std::vector<int> m_horRun;
+		std::vector<int> m_verRun;
+	
+	public:
+		// Builds the index from a board's sum cells
+		RunIndex(const std::vector<std::vector<Cell>>& board);
+	
+	public:
+		unsigned height() const;
+		unsigned width() const;
+		
+		// The flat index of the cell at the given row and column
+		unsigned index(unsigned i, unsigned j) const;
+		
+		// All runs on the board
+		const std::vector<Run>& runs() const;
+		
+		// The run containing a cell horizontally or vertically (-1 if there is none)
+		int horizontalRun(unsigned index) const;
+		int verticalRun(unsigned index) const;
+};
+
+#endif
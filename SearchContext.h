@@ -0,0 +1,145 @@
+/**
+  * SearchContext.h
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This class holds the state shared by every config in one search.
+  *		 It carries the heuristic options picked for the search and anything the heuristics learn along the way.
+  *		 Configs hold a shared pointer to it, so a successor sees exactly what its parent saw.
+  *		 It outlives restarts of the search, so what was learned (the run weights) carries over to the next attempt.
+  */
+
+#ifndef KCONTEXT_H
+#define KCONTEXT_H
+
+#include <string>
+#include <vector>
+
+// Policies for picking the cell to branch on
+enum class CellOrdering {
+	// Any cell with the fewest possible values (the original policy)
+	FirstFewest,
+	
+	// The cell with the fewest possible values, breaking ties by the most unfilled peers
+	MinRemainingDegree,
+	
+	// The cell with the smallest ratio of possible values to failure-weighted run degree
+	DomWDeg,
+	
+	// The smallest-domain cell of the run with the fewest remaining combinations for its sum
+	TightestRun
+};
+
+// Policies for ordering the candidate values of the branching cell
+enum class ValueOrdering {
+	// 1 through 9 (the original behaviour)
+	Ascending,
+	
+	// Values leaving the most combinations open in the cell's runs first
+	LeastConstraining
+};
+
+struct SearchOptions {
+	CellOrdering cellOrdering;
+	ValueOrdering valueOrdering;
+	
+	// Whether cell domains are kept within the bounds their runs' remaining sums allow
+	bool propagateBounds;
+	
+	// Whether runs keep their feasible value combinations and prune cell domains against them
+	bool propagateCombinations;
+	
+	// Whether the solver splits configs into parts that share no runs and solves them separately
+	bool decompose;
+	
+	// Whether ties in cell and value ordering are broken at random (for restarts), and the seed to replay them from
+	bool randomTies;
+	unsigned seed;
+	
+	SearchOptions() : 
+		cellOrdering(CellOrdering::MinRemainingDegree), valueOrdering(ValueOrdering::Ascending), propagateBounds(true), propagateCombinations(true), decompose(true), 
+		randomTies(false), seed(0) {}
+};
+
+// Converts between cell orderings and their command line names
+inline std::string cellOrderingName(CellOrdering ordering) {
+	switch(ordering) {
+		case CellOrdering::FirstFewest: return "first-fewest";
+		case CellOrdering::MinRemainingDegree: return "mrv-degree";
+		case CellOrdering::DomWDeg: return "dom-wdeg";
+		case CellOrdering::TightestRun: return "tightest-run";
+	}
+	
+	return "";
+}
+
+inline bool cellOrderingFromName(const std::string& name, CellOrdering& ordering) {
+	for(CellOrdering o : {CellOrdering::FirstFewest, CellOrdering::MinRemainingDegree, CellOrdering::DomWDeg, CellOrdering::TightestRun}) {
+		if(cellOrderingName(o) == name) {
+			ordering = o;
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+// Converts between value orderings and their command line names
+inline std::string valueOrderingName(ValueOrdering ordering) {
+	switch(ordering) {
+		case ValueOrdering::Ascending: return "ascending";
+		case ValueOrdering::LeastConstraining: return "least-constraining";
+	}
+	
+	return "";
+}
+
+inline bool valueOrderingFromName(const std::string& name, ValueOrdering& ordering) {
+	for(ValueOrdering o : {ValueOrdering::Ascending, ValueOrdering::LeastConstraining}) {
+		if(valueOrderingName(o) == name) {
+			ordering = o;
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+class SearchContext {
+	private:
+		SearchOptions m_options;
+		
+		// Failure weights per run, used by dom/wdeg (every run starts at 1)
+		std::vector<unsigned> m_runWeights;
+	
+	public:
+		SearchContext(const SearchOptions& options, unsigned numRuns) : m_options(options), m_runWeights(numRuns, 1) {}
+	
+	public:
+		const SearchOptions& options() const {
+			return m_options;
+		}
+		
+		// The failure weight of a run
+		unsigned runWeight(int run) const {
+			return m_runWeights[run];
+		}
+		
+		// Records that a run took part in a dead end
+		// Parts of a split config are solved concurrently, but they never share a run, so they never bump the same weight
+		void bumpRunWeight(int run) {
+			++m_runWeights[run];
+		}
+		
+		// Every run's failure weight, for saving and restoring what the search has learned
+		const std::vector<unsigned>& runWeights() const {
+			return m_runWeights;
+		}
+		
+		void setRunWeights(const std::vector<unsigned>& weights) {
+			if(weights.size() == m_runWeights.size()) m_runWeights = weights;
+		}
+};
+
+#endif
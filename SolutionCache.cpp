@@ -0,0 +1,448 @@
+/**
+  * SolutionCache.cpp
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This is an implementation of SolutionCache.h.
+  * 		 For an explanation of the class, please consult that file.
+  */
+
+#include "Cell.h"
+#include "KakuroConfig.h"
+#include "SolutionCache.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// The file starts with a magic number and a format version; each record starts with its own magic number and length
+// A record holds the key's hash, the canonical clue encoding, one solved value per canonical cell (0 for sum cells) and a checksum of everything before it
+static const uint32_t fileMagic = 0x4C4F534B;
+static const uint32_t fileVersion = 1;
+static const size_t headerSize = 8;
+
+static const uint32_t recordMagic = 0x4345524B;
+static const size_t recordOverhead = 32;
+
+// FNV-1a, used to check that a record was written whole
+static uint32_t checksum(const unsigned char* data, size_t length) {
+	uint32_t hash = 2166136261u;
+	for(size_t i = 0; i < length; ++i) {
+		hash = (hash ^ data[i]) * 16777619u;
+	}
+	
+	return hash;
+}
+
+static uint64_t rotl(uint64_t x, int r) {
+	return (x << r) | (x >> (64 - r));
+}
+
+static uint64_t fmix(uint64_t k) {
+	k ^= k >> 33;
+	k *= 0xFF51AFD7ED558CCDULL;
+	k ^= k >> 33;
+	k *= 0xC4CEB9FE1A85EC53ULL;
+	k ^= k >> 33;
+	
+	return k;
+}
+
+// MurmurHash3 (x64, 128-bit) with a seed of 0
+static void murmur3(const unsigned char* data, size_t length, uint64_t& hi, uint64_t& lo) {
+	const uint64_t c1 = 0x87C37B91114253D5ULL, c2 = 0x4CF5AD432745937FULL;
+	uint64_t h1(0), h2(0);
+	
+	size_t blocks = length / 16;
+	
+	for(size_t i = 0; i < blocks; ++i) {
+		uint64_t k1, k2;
+		memcpy(&k1, data + i * 16, 8);
+		memcpy(&k2, data + i * 16 + 8, 8);
+		
+		k1 *= c1; k1 = rotl(k1, 31); k1 *= c2; h1 ^= k1;
+		h1 = rotl(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52DCE729;
+		
+		k2 *= c2; k2 = rotl(k2, 33); k2 *= c1; h2 ^= k2;
+		h2 = rotl(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495AB5;
+	}
+	
+	// The last (up to 15) bytes
+	const unsigned char* tail = data + blocks * 16;
+	uint64_t k1(0), k2(0);
+	
+	for(size_t i = length & 15; i > 8; --i) k2 ^= uint64_t(tail[i - 1]) << ((i - 9) * 8);
+	for(size_t i = min<size_t>(length & 15, 8); i > 0; --i) k1 ^= uint64_t(tail[i - 1]) << ((i - 1) * 8);
+	
+	if(k2) { k2 *= c2; k2 = rotl(k2, 33); k2 *= c1; h2 ^= k2; }
+	if(k1) { k1 *= c1; k1 = rotl(k1, 31); k1 *= c2; h1 ^= k1; }
+	
+	h1 ^= length;
+	h2 ^= length;
+	
+	h1 += h2;
+	h2 += h1;
+	
+	h1 = fmix(h1);
+	h2 = fmix(h2);
+	
+	h1 += h2;
+	h2 += h1;
+	
+	hi = h1;
+	lo = h2;
+}
+
+// The cell at row i and column j of a board, or of its transpose
+static const Cell& cellOf(const vector<vector<Cell>>& board, unsigned i, unsigned j, bool transposed) {
+	return transposed ? board[j][i] : board[i][j];
+}
+
+// The clue layout of a board (or its transpose) as bytes: the dimensions, then 0xFF and both sums for sum cells and the fixed value (or 0) for value cells
+static vector<unsigned char> encode(const vector<vector<Cell>>& board, bool transposed) {
+	unsigned rows = transposed ? board[0].size() : board.size();
+	unsigned cols = transposed ? board.size() : board[0].size();
+	
+	vector<unsigned char> bytes {(unsigned char)(rows >> 8), (unsigned char)rows, (unsigned char)(cols >> 8), (unsigned char)cols};
+	
+	for(unsigned i = 0; i < rows; ++i) {
+		for(unsigned j = 0; j < cols; ++j) {
+			const Cell& c = cellOf(board, i, j, transposed);
+			
+			if(c.isValueCell()) {
+				bytes.push_back(c.isFixed() ? c.value() : 0);
+			} else {
+				// Transposing turns down sums into right sums and vice versa
+				bytes.push_back(0xFF);
+				bytes.push_back(transposed ? c.rightSum() : c.downSum());
+				bytes.push_back(transposed ? c.downSum() : c.rightSum());
+			}
+		}
+	}
+	
+	return bytes;
+}
+
+static void put32(vector<unsigned char>& bytes, uint32_t value) {
+	bytes.insert(bytes.end(), (unsigned char*)&value, (unsigned char*)&value + 4);
+}
+
+static void put64(vector<unsigned char>& bytes, uint64_t value) {
+	bytes.insert(bytes.end(), (unsigned char*)&value, (unsigned char*)&value + 8);
+}
+
+static uint32_t get32(const unsigned char* data) {
+	uint32_t value;
+	memcpy(&value, data, 4);
+	return value;
+}
+
+static uint64_t get64(const unsigned char* data) {
+	uint64_t value;
+	memcpy(&value, data, 8);
+	return value;
+}
+
+// Writes all of a buffer, retrying short writes
+static bool writeAll(int fd, const unsigned char* data, size_t length) {
+	while(length > 0) {
+		ssize_t written = write(fd, data, length);
+		if(written <= 0) return false;
+		
+		data += written;
+		length -= written;
+	}
+	
+	return true;
+}
+
+PuzzleKey SolutionCache::keyOf(const vector<vector<Cell>>& board) {
+	PuzzleKey key;
+	key.hi = key.lo = 0;
+	key.transposed = false;
+	
+	if(board.empty() || board[0].empty()) return key;
+	
+	// The canonical orientation is whichever encodes smaller
+	key.encoding = encode(board, false);
+	vector<unsigned char> transposed = encode(board, true);
+	
+	if(transposed < key.encoding) {
+		key.encoding.swap(transposed);
+		key.transposed = true;
+	}
+	
+	murmur3(key.encoding.data(), key.encoding.size(), key.hi, key.lo);
+	
+	return key;
+}
+
+SolutionCache::SolutionCache(const string& path, bool writer, size_t maxBytes) :
+	m_path(path), m_writer(writer), m_maxBytes(maxBytes), m_fd(-1), m_lockFd(-1), m_map(nullptr), m_mapSize(0), m_indexed(0), m_index() {
+	// The writer holds the lock for as long as it has the store open
+	if(m_writer) {
+		m_lockFd = ::open((m_path + ".lock").c_str(), O_RDWR | O_CREAT, 0644);
+		
+		if(m_lockFd == -1 || flock(m_lockFd, LOCK_EX | LOCK_NB) != 0) {
+			if(m_lockFd != -1) ::close(m_lockFd);
+			m_lockFd = -1;
+			m_writer = false;
+		}
+	}
+	
+	open();
+}
+
+SolutionCache::~SolutionCache() {
+	close();
+	
+	if(m_lockFd != -1) {
+		flock(m_lockFd, LOCK_UN);
+		::close(m_lockFd);
+	}
+}
+
+bool SolutionCache::open() {
+	m_fd = ::open(m_path.c_str(), m_writer ? (O_RDWR | O_CREAT | O_APPEND) : O_RDONLY, 0644);
+	if(m_fd == -1) return false;
+	
+	m_indexed = 0;
+	m_index.clear();
+	
+	struct stat st;
+	if(m_writer && fstat(m_fd, &st) == 0 && st.st_size == 0) {
+		vector<unsigned char> header;
+		put32(header, fileMagic);
+		put32(header, fileVersion);
+		writeAll(m_fd, header.data(), header.size());
+	}
+	
+	refresh();
+	
+	// A writer that died mid-record leaves a torn tail; cut it off so new records follow the last whole one
+	if(m_writer && m_indexed > 0 && m_indexed < m_mapSize) {
+		if(ftruncate(m_fd, m_indexed) == 0) refresh();
+	}
+	
+	return true;
+}
+
+void SolutionCache::close() {
+	if(m_map != nullptr) munmap((void*)m_map, m_mapSize);
+	if(m_fd != -1) ::close(m_fd);
+	
+	m_map = nullptr;
+	m_mapSize = 0;
+	m_fd = -1;
+	m_indexed = 0;
+	m_index.clear();
+}
+
+void SolutionCache::refresh() {
+	if(m_fd == -1) {
+		open();
+		return;
+	}
+	
+	// A compaction renames a new file over ours
+	struct stat pathStat, fdStat;
+	if(stat(m_path.c_str(), &pathStat) == 0 && fstat(m_fd, &fdStat) == 0 && (pathStat.st_ino != fdStat.st_ino || pathStat.st_dev != fdStat.st_dev)) {
+		close();
+		open();
+		return;
+	}
+	
+	if(fstat(m_fd, &fdStat) != 0) return;
+	
+	size_t size = fdStat.st_size;
+	
+	if(size != m_mapSize) {
+		if(m_map != nullptr) munmap((void*)m_map, m_mapSize);
+		m_map = nullptr;
+		m_mapSize = 0;
+		
+		if(size > 0) {
+			void* map = mmap(nullptr, size, PROT_READ, MAP_SHARED, m_fd, 0);
+			if(map == MAP_FAILED) return;
+			
+			m_map = (const unsigned char*)map;
+			m_mapSize = size;
+		}
+	}
+	
+	// Nothing is indexed until the header checks out (it may not be written yet)
+	if(m_indexed == 0) {
+		if(m_mapSize < headerSize || get32(m_map) != fileMagic || get32(m_map + 4) != fileVersion) return;
+		m_indexed = headerSize;
+	}
+	
+	for(size_t length; (length = recordLength(m_indexed)) > 0; m_indexed += length) {
+		m_index[make_pair(get64(m_map + m_indexed + 8), get64(m_map + m_indexed + 16))] = m_indexed;
+	}
+}
+
+size_t SolutionCache::recordLength(size_t offset) const {
+	if(offset + recordOverhead > m_mapSize) return 0;
+	
+	const unsigned char* record = m_map + offset;
+	
+	uint32_t length = get32(record + 4);
+	if(get32(record) != recordMagic || length < recordOverhead || offset + length > m_mapSize) return 0;
+	
+	if(checksum(record, length - 4) != get32(record + length - 4)) return 0;
+	
+	return length;
+}
+
+bool SolutionCache::isOpen() const {
+	return m_fd != -1;
+}
+
+bool SolutionCache::isWriter() const {
+	return m_writer;
+}
+
+size_t SolutionCache::size() {
+	refresh();
+	return m_index.size();
+}
+
+bool SolutionCache::lookup(const vector<vector<Cell>>& board, vector<vector<Cell>>& solution) {
+	if(board.empty() || board[0].empty()) return false;
+	
+	refresh();
+	
+	PuzzleKey key = keyOf(board);
+	
+	auto it = m_index.find(make_pair(key.hi, key.lo));
+	if(it == m_index.end()) return false;
+	
+	const unsigned char* record = m_map + it->second;
+	
+	// Make sure it really is our puzzle and not a hash collision
+	uint32_t encodingLength = get32(record + 24);
+	if(encodingLength != key.encoding.size() || memcmp(record + 28, key.encoding.data(), encodingLength) != 0) return false;
+	
+	const unsigned char* values = record + 28 + encodingLength;
+	unsigned rows = board.size(), cols = board[0].size();
+	
+	vector<vector<Cell>> solved = board;
+	
+	for(unsigned i = 0; i < rows; ++i) {
+		for(unsigned j = 0; j < cols; ++j) {
+			Cell& c = solved[i][j];
+			if(!c.isValueCell()) continue;
+			
+			int value = key.transposed ? values[j * rows + i] : values[i * cols + j];
+			
+			// Values the player already filled in have to agree with the stored solution
+			if(c.value() != 0 && c.value() != value) return false;
+			
+			c.setValue(value);
+		}
+	}
+	
+	solution.swap(solved);
+	
+	return true;
+}
+
+bool SolutionCache::store(const vector<vector<Cell>>& board, const vector<vector<Cell>>& solution) {
+	if(!m_writer || m_fd == -1 || board.empty() || board[0].empty()) return false;
+	
+	if(solution.size() != board.size() || solution[0].size() != board[0].size() || !KakuroConfig::isSolution(solution)) return false;
+	
+	PuzzleKey key = keyOf(board);
+	unsigned rows = board.size(), cols = board[0].size();
+	
+	vector<unsigned char> record;
+	put32(record, recordMagic);
+	put32(record, recordOverhead + key.encoding.size() + rows * cols);
+	put64(record, key.hi);
+	put64(record, key.lo);
+	put32(record, key.encoding.size());
+	record.insert(record.end(), key.encoding.begin(), key.encoding.end());
+	
+	// Values go in canonical order, so the record serves the board and its transpose alike
+	unsigned canonRows = key.transposed ? cols : rows, canonCols = key.transposed ? rows : cols;
+	
+	for(unsigned i = 0; i < canonRows; ++i) {
+		for(unsigned j = 0; j < canonCols; ++j) {
+			const Cell& c = cellOf(solution, i, j, key.transposed);
+			record.push_back(c.isValueCell() ? c.value() : 0);
+		}
+	}
+	
+	put32(record, checksum(record.data(), record.size()));
+	
+	refresh();
+	
+	if(m_mapSize + record.size() > m_maxBytes) compact(m_maxBytes / 2);
+	
+	if(!writeAll(m_fd, record.data(), record.size())) return false;
+	
+	refresh();
+	
+	return true;
+}
+
+bool SolutionCache::compact(size_t targetBytes) {
+	if(!m_writer || m_fd == -1) return false;
+	
+	refresh();
+	
+	// Newest records first, keeping as many as fit
+	vector<size_t> offsets;
+	for(const auto& entry : m_index) offsets.push_back(entry.second);
+	
+	sort(offsets.rbegin(), offsets.rend());
+	
+	size_t total(headerSize);
+	vector<size_t> kept;
+	
+	for(size_t offset : offsets) {
+		size_t length = recordLength(offset);
+		if(total + length > targetBytes) break;
+		
+		total += length;
+		kept.push_back(offset);
+	}
+	
+	// Write the new file beside the old one, then swap it in with a rename so readers only ever see a whole file
+	string tmpPath = m_path + ".tmp";
+	int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(fd == -1) return false;
+	
+	vector<unsigned char> header;
+	put32(header, fileMagic);
+	put32(header, fileVersion);
+	
+	bool ok = writeAll(fd, header.data(), header.size());
+	
+	for(auto it = kept.rbegin(); ok && it != kept.rend(); ++it) {
+		ok = writeAll(fd, m_map + *it, recordLength(*it));
+	}
+	
+	ok = ok && fsync(fd) == 0;
+	::close(fd);
+	
+	if(!ok || rename(tmpPath.c_str(), m_path.c_str()) != 0) {
+		unlink(tmpPath.c_str());
+		return false;
+	}
+	
+	close();
+	
+	return open();
+}
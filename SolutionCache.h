@@ -0,0 +1,99 @@
+/**
+  * SolutionCache.h
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This class is a persistent store of solved puzzles, keyed by a 128-bit hash of the puzzle's canonical clue layout.
+  *		 A board and its transpose (rows for columns, down sums for right sums) are the same puzzle, so both have the same canonical form.
+  *		 The store is an append-only file that's memory mapped for lookups; each record carries a checksum, so a half-written one is never read.
+  *		 Any number of processes can read the file while one writer (holding an exclusive lock on a ".lock" file beside it) appends.
+  *		 When the file would grow past its bound, the writer compacts it into a new file holding the newest solutions and renames it over the old one.
+  *		 Readers notice the new file and switch to it on their next lookup.
+  */
+
+#ifndef KCACHE_H
+#define KCACHE_H
+
+#include "Cell.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// The canonical form of a puzzle's clues and its hash
+struct PuzzleKey {
+	std::uint64_t hi, lo;
+	
+	// The clue layout as bytes (dimensions, then each cell in row-major order), in canonical orientation
+	std::vector<unsigned char> encoding;
+	
+	// Whether the canonical orientation is the board's transpose
+	bool transposed;
+};
+
+class SolutionCache {
+	private:
+		std::string m_path;
+		bool m_writer;
+		std::size_t m_maxBytes;
+		
+		// The open store, its mapping, and how far into it records have been indexed
+		int m_fd;
+		int m_lockFd;
+		const unsigned char* m_map;
+		std::size_t m_mapSize;
+		std::size_t m_indexed;
+		
+		// Where each key's newest record starts in the file
+		std::map<std::pair<std::uint64_t, std::uint64_t>, std::size_t> m_index;
+	
+	public:
+		// Opens (creating it if need be, when writing) a store with the given bound on its size in bytes
+		// Only one writer can have a store open at a time; a second one is opened read-only instead
+		SolutionCache(const std::string& path, bool writer, std::size_t maxBytes = 64 << 20);
+		~SolutionCache();
+		
+		// Disable copy construction
+		SolutionCache(const SolutionCache& other) = delete;
+		
+		// Disable assignment
+		void operator=(const SolutionCache& other) = delete;
+	
+	public:
+		// The canonical key of a board's clues: its sum cells and the values fixed on loading
+		static PuzzleKey keyOf(const std::vector<std::vector<Cell>>& board);
+	
+	private:
+		// (Re)opens the store file and maps it, starting the index from scratch
+		bool open();
+		void close();
+		
+		// Picks up records appended since the last look, and switches to a compacted file if one replaced ours
+		void refresh();
+		
+		// Checks the record starting at an offset, returning its length (0 if it isn't whole or doesn't check out)
+		std::size_t recordLength(std::size_t offset) const;
+	
+	public:
+		// Whether the store could be opened, and whether we're the one allowed to write to it
+		bool isOpen() const;
+		bool isWriter() const;
+		
+		// The number of puzzles in the store
+		std::size_t size();
+		
+		// Finds the solution to a board's puzzle, returning false if it isn't stored or doesn't fit the board's filled cells
+		bool lookup(const std::vector<std::vector<Cell>>& board, std::vector<std::vector<Cell>>& solution);
+		
+		// Stores the solution to a board's puzzle; returns false if we aren't the writer
+		bool store(const std::vector<std::vector<Cell>>& board, const std::vector<std::vector<Cell>>& solution);
+		
+		// Rewrites the store with only the newest record per puzzle, dropping the oldest until it fits in targetBytes
+		bool compact(std::size_t targetBytes);
+};
+
+#endif
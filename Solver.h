@@ -7,58 +7,733 @@
   * Description: This is the generalized backtracking solver.
   *		 It's initialized with a configuration and solved during construction.
   *		 One may check its success status and solution path via accessor functions.
+  *		 Configurations that split into independent parts are solved part by part (in parallel where threads are free) and stitched back together.
+  *		 The solution path then skips from the split straight to the stitched config.
+  *		 A solve can be bounded by a node budget, a deadline and a cancellation flag; hitting any of them stops the search with its own status.
+  *		 It can also restart itself on a schedule of growing node limits, reseeding the config's random tie-breaking for each attempt.
+  *		 What it counts along the way is up to its statistics policy (see SolverStats.h); NoStats counts nothing at no cost.
+  *		 A progress callback, if given, hears every so many nodes an online estimate of the search tree's size, how far along the solve is and the time left.
+  *		 With a checkpoint file set, the search path is saved every so often (and when the search is cut short), and a later Solver can pick the search up from it (see Checkpoint.h).
+  *		 While the Tracer is running, every node entered, child tried, dead end and backtrack is recorded (see Trace.h).
   */
 
+#ifndef KSOLVER_H
+#define KSOLVER_H
 
+#include "Checkpoint.h"
+#include "SolverStats.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
 #include <memory>
+#include <string>
+#include <thread>
 #include <vector>
 
 using namespace std;
 
-template <class T>
+// How a solve ended
+enum class SolveStatus {
+	Solved,
+	
+	// The whole search space was explored without finding a solution
+	Unsolvable,
+	
+	// The node budget or the deadline ran out first
+	BudgetExceeded,
+	
+	// The cancellation flag was raised
+	Cancelled
+};
+
+// How far along a solve is, as told to its progress callback
+// The search tree's size is estimated with the weighted backtrack estimator: each dead end gives Knuth's estimate for its path (1 + b1 + b1 b2 + ..., from the branching factors above it),
+// weighted by the chance a random probe from the root would reach it (1 / (b1 b2 ...)); once the whole tree is searched the estimate is exact
+// It describes the tree as if it were searched to the end; a solvable puzzle stops at its first solution, usually well before that
+struct SolveProgress {
+	long nodes;
+	
+	// The nodes the search is estimated to visit in all (0 until it has met a dead end), counting abandoned attempts as they were
+	double estimatedNodes;
+	
+	// The nodes visited as a fraction of the estimate
+	double fraction;
+	
+	// The time taken so far and the time estimated to be left (-1 until there's an estimate)
+	double elapsedMs;
+	double remainingMs;
+};
+
+typedef function<void(const SolveProgress&)> ProgressCallback;
+
+struct SolverLimits {
+	// The most nodes to visit (0 means no limit)
+	long maxNodes;
+	
+	// The time by which to give up, if there is one
+	bool hasDeadline;
+	chrono::steady_clock::time_point deadline;
+	
+	// Raised by anyone (e.g. another thread) to stop the solve
+	shared_ptr<atomic<bool>> cancelled;
+	
+	// Set for the parts of a split config: one flag per split above the part, raised once that split can no longer succeed (a sibling part failed or its solver stopped)
+	vector<shared_ptr<atomic<bool>>> abandoned;
+	
+	// Set once the parts of a split config run side by side: the nodes left for all of them (and the parts of their own splits) to draw on, so together they keep to the budget
+	shared_ptr<atomic<long>> pool;
+	
+	// Called every progressNodes nodes, on the solving thread (it may raise the cancellation flag)
+	ProgressCallback progress;
+	long progressNodes;
+	
+	// Where to keep a checkpoint of the search (nowhere if empty), and how often to rewrite it
+	// Writing one costs time in proportion to the depth of the search, so the interval bounds what checkpointing costs
+	// While checkpointing, the parts of a split config are solved one after another rather than in parallel, so the search is a single path
+	string checkpointFile;
+	long checkpointMs;
+	
+	SolverLimits() : maxNodes(0), hasDeadline(false), deadline(), cancelled(), abandoned(), pool(), progress(), progressNodes(4096), checkpointFile(), checkpointMs(60000) {}
+	
+	// Sets the deadline a number of milliseconds from now
+	void setTimeout(long ms) {
+		hasDeadline = true;
+		deadline = chrono::steady_clock::now() + chrono::milliseconds(ms);
+	}
+};
+
+// When a solve abandons its current attempt and starts again from the root
+enum class RestartPolicy {
+	None,
+	
+	// Limits follow the Luby sequence (1, 1, 2, 1, 1, 2, 4, ...) times the base
+	Luby,
+	
+	// Limits start at the base and grow by a constant factor
+	Geometric
+};
+
+// Converts between restart policies and their command line names
+inline string restartPolicyName(RestartPolicy policy) {
+	switch(policy) {
+		case RestartPolicy::None: return "none";
+		case RestartPolicy::Luby: return "luby";
+		case RestartPolicy::Geometric: return "geometric";
+	}
+	
+	return "";
+}
+
+inline bool restartPolicyFromName(const string& name, RestartPolicy& policy) {
+	for(RestartPolicy p : {RestartPolicy::None, RestartPolicy::Luby, RestartPolicy::Geometric}) {
+		if(restartPolicyName(p) == name) {
+			policy = p;
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+struct RestartSchedule {
+	RestartPolicy policy;
+	
+	// The node limit of the first attempt
+	long baseNodes;
+	
+	// The growth per attempt of geometric limits
+	double factor;
+	
+	RestartSchedule() : policy(RestartPolicy::None), baseNodes(100), factor(1.5) {}
+	
+	// The node limit of an attempt, counting from 0
+	long limit(unsigned attempt) const {
+		if(policy == RestartPolicy::Geometric) {
+			double nodes = baseNodes;
+			for(unsigned k = 0; k < attempt; ++k) nodes *= factor;
+			
+			return long(nodes);
+		}
+		
+		// Luby: term i is 2^(k-1) if i = 2^k - 1, and otherwise repeats the sequence from its start
+		unsigned long i = attempt + 1;
+		
+		while(true) {
+			unsigned long k = 1;
+			while((1UL << k) - 1 < i) ++k;
+			
+			if(i == (1UL << k) - 1) return baseNodes * long(1UL << (k - 1));
+			
+			i -= (1UL << (k - 1)) - 1;
+		}
+	}
+};
+
+template <class T, class Stats = CountingStats>
 class Solver {
 	private:
 		bool m_failure;
-		int m_deadEnds;
-		int m_maxDepth;
+		SolveStatus m_status;
+		SolverLimits m_limits;
+		RestartSchedule m_schedule;
+		
+		// The node count at which the current attempt ends (0 for never), whether it has, and how many attempts were abandoned
+		long m_cutoff;
+		bool m_restartDue;
+		int m_restarts;
+		
+		// Nodes are always counted, since the node budget depends on them; anything else is left to the policy
+		long m_nodes;
+		
+		// The nodes drawn from the shared pool, if there is one; a solver may only visit as many as it has drawn
+		long m_drawn;
+		Stats m_stats;
+		double m_elapsedMs;
 		vector<shared_ptr<T>> m_path;
+		
+		// When the solve began, and the node count when the current attempt began
+		chrono::steady_clock::time_point m_start;
+		long m_attemptStart;
+		
+		// Over the current attempt's dead ends: the sum of their weights, and of their weighted Knuth estimates
+		double m_covered;
+		double m_weighted;
+		
+		// The node count last reported
+		long m_reported;
+		
+		// One level of the path being searched, kept so it can be checkpointed
+		struct Level {
+			// A branch: the children, the one being searched, how many there were to begin with, and the random state they began with
+			const vector<shared_ptr<T>>* children;
+			unsigned current;
+			unsigned branches;
+			uint64_t rngState;
+			
+			// A split: the parts, the cells each finished part filled, and the solver of the part being solved
+			const vector<shared_ptr<T>>* parts;
+			vector<vector<array<int, 3>>> finished;
+			const Solver* active;
+		};
+		
+		vector<Level> m_levels;
+		
+		// The solver whose parts this one solves (null for the outermost), and the attempt under way
+		Solver* m_outer;
+		unsigned m_attempt;
+		
+		// Kept by the outermost solver only: the root config and board, the checkpoint being resumed (null once its path is replayed) and how far, and when the last checkpoint was written
+		shared_ptr<T> m_root;
+		vector<vector<Cell>> m_rootBoard;
+		const Checkpoint* m_resume;
+		unsigned m_resumed;
+		chrono::steady_clock::time_point m_lastCheckpoint;
+		long m_checkpoints;
 	
 	private:
-		shared_ptr<T> solve(shared_ptr<T> config, int depth = 1) {
-			if(depth > m_maxDepth) {
-				m_maxDepth = depth;
+		// Whether the search has been stopped by one of its limits
+		bool stopped() const {
+			return m_restartDue || m_status == SolveStatus::BudgetExceeded || m_status == SolveStatus::Cancelled;
+		}
+		
+		// Whether the overall node budget or deadline has run out
+		bool budgetSpent() const {
+			return (m_limits.maxNodes > 0 && m_nodes >= m_limits.maxNodes) || (m_limits.hasDeadline && chrono::steady_clock::now() >= m_limits.deadline);
+		}
+		
+		// The nodes left before the budget or the current attempt runs out (0 for no limit)
+		long allowance() const {
+			long nodes(0);
+			
+			if(m_limits.maxNodes > 0) nodes = max(1L, m_limits.maxNodes - m_nodes);
+			if(m_cutoff > 0) nodes = (nodes > 0) ? min(nodes, max(1L, m_cutoff - m_nodes)) : max(1L, m_cutoff - m_nodes);
+			
+			return nodes;
+		}
+		
+		// Whether a split config this solver is solving a part of has been given up on
+		bool abandonedSplit() const {
+			for(const shared_ptr<atomic<bool>>& flag : m_limits.abandoned) {
+				if(flag->load(memory_order_relaxed)) return true;
+			}
+			
+			return false;
+		}
+		
+		// Draws the next nodes to visit from the shared pool, returning whether there were any left
+		// They're drawn 256 at a time so threads rarely touch the pool; what's left over is given back when the solve ends
+		bool draw() {
+			long before = m_limits.pool->fetch_sub(256);
+			long drawn = min(256L, max(0L, before));
+			
+			if(drawn < 256) m_limits.pool->fetch_add(256 - drawn);
+			m_drawn += drawn;
+			
+			return m_nodes <= m_drawn;
+		}
+		
+		// Checks the limits on entering a node; the clock and the flags of the splits above are only read every 256 nodes to keep this cheap
+		bool outOfBudget() {
+			if(stopped()) return true;
+			
+			if(m_limits.cancelled && m_limits.cancelled->load(memory_order_relaxed)) {
+				m_status = SolveStatus::Cancelled;
+			} else if(!m_limits.abandoned.empty() && (m_nodes & 255) == 0 && abandonedSplit()) {
+				m_status = SolveStatus::Cancelled;
+			} else if(m_limits.maxNodes > 0 && m_nodes > m_limits.maxNodes) {
+				m_status = SolveStatus::BudgetExceeded;
+			} else if(m_limits.pool && m_nodes > m_drawn && !draw()) {
+				m_status = SolveStatus::BudgetExceeded;
+			} else if(m_limits.hasDeadline && (m_nodes & 255) == 0 && chrono::steady_clock::now() >= m_limits.deadline) {
+				m_status = SolveStatus::BudgetExceeded;
+			} else if(m_cutoff > 0 && m_nodes > m_cutoff) {
+				m_restartDue = true;
 			}
 			
+			return stopped();
+		}
+		
+		// Counts a finished dead end (or split config) toward the estimate, given its weight and the Knuth estimate of its path
+		void onLeaf(double share, double knuth) {
+			m_covered += share;
+			m_weighted += share * knuth;
+		}
+		
+		// Tells the progress callback where the solve stands, given the current attempt's estimated tree size (0 for none yet)
+		// Nothing is told if it was told too recently; parts report through here, so they're held to our pace
+		void report(long nodes, double attemptNodes, bool force = false) {
+			if(!force && nodes - m_reported < m_limits.progressNodes) return;
+			m_reported = nodes;
+			
+			SolveProgress progress;
+			progress.nodes = nodes;
+			progress.estimatedNodes = attemptNodes > 0 ? max(double(nodes), m_attemptStart + attemptNodes) : 0;
+			progress.fraction = attemptNodes > 0 ? nodes / progress.estimatedNodes : 0;
+			progress.elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - m_start).count();
+			progress.remainingMs = progress.fraction > 0 ? progress.elapsedMs * (1 - progress.fraction) / progress.fraction : -1;
+			
+			m_limits.progress(progress);
+		}
+		
+		// The current attempt's estimated tree size (0 for none yet)
+		double estimate() const {
+			return m_covered > 0 ? m_weighted / m_covered : 0;
+		}
+		
+		// The solver at the top of the search
+		Solver& outermost() {
+			Solver* solver = this;
+			while(solver->m_outer != nullptr) solver = solver->m_outer;
+			
+			return *solver;
+		}
+		
+		bool checkpointing() const {
+			return !m_limits.checkpointFile.empty();
+		}
+		
+		// Whether the checkpoint interval has passed; the clock is only read every 256 nodes
+		bool checkpointDue() {
+			if(!checkpointing() || (m_nodes & 255) != 0) return false;
+			
+			return chrono::steady_clock::now() - outermost().m_lastCheckpoint >= chrono::milliseconds(m_limits.checkpointMs);
+		}
+		
+		// The cells (row, column, value) a finished part filled
+		static vector<array<int, 3>> filledCells(const T& part, const T& solution) {
+			vector<array<int, 3>> cells;
+			vector<vector<Cell>> before = part.getBoard(), after = solution.getBoard();
+			
+			for(unsigned i = 0; i < before.size(); ++i) {
+				for(unsigned j = 0; j < before[i].size(); ++j) {
+					if(before[i][j].isValueCell() && before[i][j].value() == 0 && after[i][j].value() != 0) cells.push_back(array<int, 3>{{int(i), int(j), after[i][j].value()}});
+				}
+			}
+			
+			return cells;
+		}
+		
+		// Adds this solver's levels of the path to a checkpoint, followed by those of the part it's solving, if any
+		void saveLevels(Checkpoint& checkpoint) const {
+			for(const Level& level : m_levels) {
+				CheckpointFrame frame;
+				
+				if(level.parts != nullptr) {
+					frame.split = true;
+					frame.parts = level.parts->size();
+					frame.finished = level.finished;
+				} else {
+					const vector<shared_ptr<T>>& children = *level.children;
+					
+					frame.cell = children[level.current]->deltaCell();
+					frame.branches = level.branches;
+					frame.value = children[level.current]->deltaValue();
+					frame.rngState = level.rngState;
+					
+					for(unsigned k = level.current + 1; k < children.size(); ++k) frame.remaining.push_back(children[k]->deltaValue());
+				}
+				
+				checkpoint.frames.push_back(frame);
+				
+				// The part's nodes aren't ours until it finishes
+				if(level.active != nullptr) {
+					checkpoint.nodes += level.active->m_nodes;
+					level.active->saveLevels(checkpoint);
+				}
+			}
+		}
+		
+		// Writes a checkpoint of the whole search; uncounted is the number of nodes just entered that a resumed search will enter (and count) again
+		void writeCheckpoint(long uncounted) {
+			Solver& top = outermost();
+			
+			Checkpoint checkpoint;
+			checkpoint.board = top.m_rootBoard;
+			checkpoint.options = top.m_root->searchOptions();
+			checkpoint.nodes = top.m_nodes - uncounted;
+			checkpoint.attempt = top.m_attempt;
+			checkpoint.attemptStart = top.m_attemptStart;
+			checkpoint.restarts = top.m_restarts;
+			checkpoint.covered = top.m_covered;
+			checkpoint.weighted = top.m_weighted;
+			checkpoint.runWeights = top.m_root->runWeights();
+			
+			top.saveLevels(checkpoint);
+			
+			if(checkpoint.write(m_limits.checkpointFile)) ++top.m_checkpoints;
+			top.m_lastCheckpoint = chrono::steady_clock::now();
+		}
+		
+		// The next frame of the checkpoint being resumed, or null once its path has been replayed
+		// What the search had learned is put back only then, since replaying the path teaches it some of the same things again
+		const CheckpointFrame* resumeFrame(const shared_ptr<T>& config) {
+			Solver& top = outermost();
+			if(top.m_resume == nullptr) return nullptr;
+			
+			if(top.m_resumed < top.m_resume->frames.size()) return &top.m_resume->frames[top.m_resumed++];
+			
+			config->setRunWeights(top.m_resume->runWeights);
+			top.m_resume = nullptr;
+			
+			return nullptr;
+		}
+		
+		// Gives up on replaying a checkpoint whose path doesn't fit the search (which only happens if it was taken of another search), carrying on from here as a fresh search
+		void abandonResume() {
+			outermost().m_resume = nullptr;
+		}
+		
+		// The number of extra threads currently solving parts, shared by every solver of this config type
+		static atomic<int>& busyThreads() {
+			static atomic<int> busy(0);
+			return busy;
+		}
+		
+		// Claims a thread for solving a part, if the machine has one to spare
+		static bool claimThread() {
+			int limit = max(1, int(thread::hardware_concurrency())) - 1;
+			int busy = busyThreads().load();
+			
+			while(busy < limit) {
+				if(busyThreads().compare_exchange_weak(busy, busy + 1)) return true;
+			}
+			
+			return false;
+		}
+		
+		// Solves independent parts of a config, returning their solutions (or nothing if any part has none)
+		// The config's weight and path estimate are only needed to report progress; frame is the checkpointed split being resumed, if any
+		vector<shared_ptr<T>> solveParts(vector<shared_ptr<T>>& parts, int depth, double share, double knuth, const CheckpointFrame* frame) {
+			vector<shared_ptr<Solver<T, Stats>>> solvers(parts.size());
+			vector<future<shared_ptr<Solver<T, Stats>>>> pending(parts.size());
+			vector<shared_ptr<T>> solutions(parts.size());
+			
+			// Parts share our deadline and cancellation flag, and get whatever is left of our node budget and attempt
+			// This split's own flag stops the parts still running once the config can't be solved
+			SolverLimits limits = m_limits;
+			limits.maxNodes = allowance();
+			
+			shared_ptr<atomic<bool>> abandoned = make_shared<atomic<bool>>(false);
+			limits.abandoned.push_back(abandoned);
+			
+			// Where the parts' nodes start, and parts solved on other threads keep their progress to themselves
+			long first = m_nodes;
+			SolverLimits threadLimits = limits;
+			threadLimits.progress = nullptr;
+			
+			m_levels.push_back(Level{nullptr, 0, 0, 0, &parts, vector<vector<array<int, 3>>>(), nullptr});
+			unsigned level = m_levels.size() - 1;
+			
+			// Parts a resumed checkpoint had finished are filled back in rather than solved again
+			unsigned restored = frame != nullptr ? frame->finished.size() : 0;
+			
+			for(unsigned k = 0; k < parts.size(); ++k) {
+				// Each part is its own search; its path shouldn't run back up through ours
+				parts[k]->setParent(nullptr);
+				
+				if(k < restored) {
+					solutions[k] = make_shared<T>(*parts[k]);
+					for(const array<int, 3>& cell : frame->finished[k]) solutions[k]->setCell(cell[0], cell[1], cell[2]);
+					
+					m_levels[level].finished.push_back(frame->finished[k]);
+				} else if(k + 1 < parts.size() && !checkpointing() && claimThread()) {
+					// Parts running side by side would each spend the whole allowance, so from here on they draw on one pool of it
+					if(!limits.pool && limits.maxNodes > 0) limits.pool = threadLimits.pool = make_shared<atomic<long>>(limits.maxNodes);
+					
+					shared_ptr<T> part = parts[k];
+					pending[k] = async(launch::async, [part, threadLimits, abandoned]() {
+						shared_ptr<Solver<T, Stats>> solver = make_shared<Solver<T, Stats>>(part, threadLimits);
+						
+						// The other parts are no use once this one has failed, so they're stopped now rather than once it's waited on
+						if(solver->isFailure()) abandoned->store(true);
+						
+						--busyThreads();
+						return solver;
+					});
+				}
+			}
+			
+			// A part proven unsolvable settles the config, whatever stopped the others; failing that, a part that ran out of budget (or was cancelled) stops us
+			bool failure(false);
+			SolveStatus stop = SolveStatus::Solved;
+			
+			for(unsigned k = restored; k < parts.size(); ++k) {
+				if(pending[k].valid()) {
+					solvers[k] = pending[k].get();
+				} else if(!abandoned->load()) {
+					// Once one part has failed, the rest can't help
+					limits.maxNodes = allowance();
+					
+					// While a part is solved here, the config counts as a dead end whose subtree is the parts before it, this one, and the rest each estimated like this one
+					if(m_limits.progress) {
+						double covered = m_covered, weighted = m_weighted;
+						unsigned count = parts.size();
+						
+						limits.progress = [this, k, count, share, knuth, covered, weighted, first](const SolveProgress& part) {
+							// Until the part has met a dead end there's nothing to estimate it with
+							if(part.estimatedNodes == 0) {
+								report(m_nodes + part.nodes, 0);
+								return;
+							}
+							
+							double subtree = (m_nodes - first) + part.estimatedNodes * (count - k);
+							report(m_nodes + part.nodes, (weighted + share * knuth + subtree) / (covered + share));
+						};
+					}
+					
+					// The part's solver answers to us, so a checkpoint can run down through it
+					solvers[k].reset(new Solver<T, Stats>(parts[k], limits, RestartSchedule(), this, nullptr));
+					m_levels[level].active = nullptr;
+				} else {
+					continue;
+				}
+				
+				m_nodes += solvers[k]->m_nodes;
+				if(m_limits.pool) m_drawn += solvers[k]->m_drawn;
+				m_stats.merge(solvers[k]->m_stats, depth);
+				
+				if(solvers[k]->m_status == SolveStatus::Unsolvable) {
+					failure = true;
+				} else if(solvers[k]->stopped()) {
+					// A part stopped because the split was given up on is cancelled, so a budget running out is the better reason to give
+					if(stop != SolveStatus::BudgetExceeded) stop = solvers[k]->m_status;
+				} else {
+					solutions[k] = solvers[k]->getSolutionPath().front();
+					if(checkpointing()) m_levels[level].finished.push_back(filledCells(*parts[k], *solutions[k]));
+				}
+				
+				if(failure || stop != SolveStatus::Solved) abandoned->store(true);
+			}
+			
+			// If a part only ran out of our attempt's nodes, it's time to restart
+			if(!failure && stop != SolveStatus::Solved) {
+				if(stop == SolveStatus::BudgetExceeded && m_cutoff > 0 && !budgetSpent()) {
+					m_restartDue = true;
+				} else {
+					m_status = stop;
+				}
+			}
+			
+			m_levels.pop_back();
+			
+			return (failure || stop != SolveStatus::Solved) ? vector<shared_ptr<T>>() : solutions;
+		}
+		
+		// The share is the config's weight (1 / the product of the branching factors above it) and knuth is Knuth's estimate for the path to it
+		shared_ptr<T> solve(shared_ptr<T> config, int depth = 1, double share = 1, double knuth = 1) {
+			const CheckpointFrame* frame = resumeFrame(config);
+			
+			// Nodes on a resumed checkpoint's path were counted before it was written
+			if(frame == nullptr) {
+				if(checkpointDue()) writeCheckpoint(0);
+				
+				++m_nodes;
+				
+				bool wasStopped = stopped();
+				
+				if(outOfBudget()) {
+					// A search cut short saves where it got to, so it can be picked up again
+					if(!wasStopped && !m_restartDue && checkpointing()) writeCheckpoint(1);
+					return nullptr;
+				}
+				
+				if(m_limits.progress && m_limits.progressNodes > 0 && m_nodes % m_limits.progressNodes == 0) report(m_nodes, estimate());
+			}
+			
+			KAKURO_TRACE(TraceEvent::Enter, config->deltaCell(), config->deltaValue(), depth, 0);
+			
+			m_stats.onNode(depth);
+			
 			if(config->isGoal()) {
 				return config;
 			}
 			
-			vector<shared_ptr<T>> succ = config->getSuccessors();
+			// Parts of the board that share no runs can't affect each other, so failing in one mustn't send us back through the others
+			vector<shared_ptr<T>> parts = config->splitComponents();
+			
+			if(frame != nullptr && frame->split != (parts.size() > 1)) {
+				abandonResume();
+				frame = nullptr;
+			}
+			
+			if(parts.size() > 1) {
+				long before = m_nodes;
+				vector<shared_ptr<T>> solutions = solveParts(parts, depth, share, knuth, frame);
+				
+				if(solutions.empty()) {
+					// Its subtree is the parts' nodes (less the config itself, already counted in the path estimate)
+					if(!stopped()) onLeaf(share, knuth + (m_nodes - before) / share);
+					return nullptr;
+				}
+				
+				shared_ptr<T> merged = T::mergeComponents(*config, solutions);
+				merged->setParent(config);
+				
+				return merged;
+			}
+			
+			vector<shared_ptr<T>> succ;
+			
+			if(frame != nullptr) {
+				// The child being searched when the checkpoint was written, then the siblings not yet tried, just as they were
+				vector<int> values(1, frame->value);
+				values.insert(values.end(), frame->remaining.begin(), frame->remaining.end());
+				
+				succ = config->getSuccessors(frame->cell, values);
+				
+				if(succ.size() == values.size()) {
+					for(shared_ptr<T>& child : succ) child->setRandomState(frame->rngState);
+				} else {
+					abandonResume();
+					frame = nullptr;
+					succ = config->getSuccessors();
+				}
+			} else {
+				uint64_t expandStart = m_stats.beginExpand();
+				succ = config->getSuccessors();
+				m_stats.endExpand(expandStart);
+			}
 			
 			if(succ.size() == 0) {
-				++m_deadEnds;
+				KAKURO_TRACE(TraceEvent::Prune, -1, 0, depth, 0);
+				m_stats.onDeadEnd();
+				onLeaf(share, knuth);
 				return nullptr;
 			}
 			
-			for(shared_ptr<T>& child : succ) {
+			// The siblings searched before the checkpoint still count toward the branching factor
+			unsigned branches = frame != nullptr ? max<unsigned>(frame->branches, succ.size()) : succ.size();
+			m_stats.onBranch(branches);
+			
+			double childShare = share / branches;
+			double childKnuth = knuth + 1 / childShare;
+			
+			m_levels.push_back(Level{&succ, 0, branches, succ.front()->randomState(), nullptr, vector<vector<array<int, 3>>>(), nullptr});
+			unsigned level = m_levels.size() - 1;
+			
+			shared_ptr<T> solution;
+			
+			for(unsigned k = 0; k < succ.size(); ++k) {
+				shared_ptr<T>& child = succ[k];
+				m_levels[level].current = k;
+				
 				if(depth > 0) {
 					child->setParent(config);
 				}
 				
-				shared_ptr<T> solution = solve(child, depth + 1);
-				if(solution != nullptr) {
-					return solution;
+				KAKURO_TRACE(TraceEvent::Assign, child->deltaCell(), child->deltaValue(), depth, succ.size());
+				
+				solution = solve(child, depth + 1, childShare, childKnuth);
+				
+				if(solution != nullptr || stopped()) {
+					break;
 				}
+				
+				m_stats.onBacktrack();
+				KAKURO_TRACE(TraceEvent::Backtrack, child->deltaCell(), child->deltaValue(), depth, succ.size());
 			}
 			
-			return nullptr;
+			m_levels.pop_back();
+			
+			return solution;
 		}
 	
-	public:
-		Solver(shared_ptr<T> initialConfig) : m_failure(false), m_deadEnds(0), m_maxDepth(0), m_path() {
-			shared_ptr<T> cursor = solve(initialConfig);
+	private:
+		// Constructor for every solver; outer is the solver whose part this one solves (if any), and resume the checkpoint to pick up from (if any)
+		Solver(shared_ptr<T> initialConfig, const SolverLimits& limits, const RestartSchedule& schedule, Solver* outer, const Checkpoint* resume) : 
+			m_failure(false), m_status(SolveStatus::Unsolvable), m_limits(limits), m_schedule(schedule), m_cutoff(0), m_restartDue(false), m_restarts(0), 
+			m_nodes(0), m_drawn(0), m_stats(), m_elapsedMs(0), m_path(), m_start(chrono::steady_clock::now()), m_attemptStart(0), m_covered(0), m_weighted(0), m_reported(0), 
+			m_levels(), m_outer(outer), m_attempt(0), m_root(initialConfig), m_rootBoard(), m_resume(resume), m_resumed(0), m_lastCheckpoint(m_start), m_checkpoints(0) {
+			if(m_outer != nullptr) {
+				m_outer->m_levels.back().active = this;
+			} else if(checkpointing()) {
+				m_rootBoard = initialConfig->getBoard();
+			}
+			
+			unsigned firstAttempt(0);
+			
+			if(m_resume != nullptr) {
+				m_nodes = m_resume->nodes;
+				m_restarts = m_resume->restarts;
+				firstAttempt = m_resume->attempt;
+			}
+			
+			shared_ptr<T> cursor;
+			
+			for(unsigned attempt = firstAttempt; ; ++attempt) {
+				m_attempt = attempt;
+				
+				// A resumed attempt carries on with the counts it had
+				bool resumed = m_resume != nullptr && attempt == m_resume->attempt;
+				
+				m_attemptStart = resumed ? m_resume->attemptStart : m_nodes;
+				m_covered = resumed ? m_resume->covered : 0;
+				m_weighted = resumed ? m_resume->weighted : 0;
+				
+				// Each attempt replays the config's tie-breaking from the seed and its own number
+				if(m_schedule.policy != RestartPolicy::None) {
+					initialConfig->reseed(attempt);
+					m_cutoff = m_attemptStart + m_schedule.limit(attempt);
+				}
+				
+				cursor = solve(initialConfig);
+				
+				if(!m_restartDue) break;
+				
+				m_restartDue = false;
+				++m_restarts;
+			}
 			
 			if(cursor != nullptr) {
+				m_status = SolveStatus::Solved;
+				
 				do {
 					m_path.push_back(cursor);
 					cursor = cursor->getParent();
@@ -66,23 +741,79 @@ class Solver {
 			} else {
 				m_failure = true;
 			}
+			
+			// A solve that settled the config is all the way along, however much of the tree it skipped
+			bool settled = m_status == SolveStatus::Solved || m_status == SolveStatus::Unsolvable;
+			if(m_limits.progress) report(m_nodes, settled ? m_nodes - m_attemptStart : estimate(), true);
+			
+			// Nodes drawn but not visited go back to the pool for the parts still running
+			if(m_limits.pool && m_drawn > m_nodes) {
+				m_limits.pool->fetch_add(m_drawn - m_nodes);
+				m_drawn = m_nodes;
+			}
+			
+			// A settled search has nothing left to resume
+			if(m_outer == nullptr && settled && checkpointing()) remove(m_limits.checkpointFile.c_str());
+			
+			m_elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - m_start).count();
 		}
 	
+	public:
+		Solver(shared_ptr<T> initialConfig, const SolverLimits& limits = SolverLimits(), const RestartSchedule& schedule = RestartSchedule()) : 
+			Solver(initialConfig, limits, schedule, nullptr, nullptr) {}
+		
+		// Constructor picking a search up from a checkpoint of it; the config must hold the board the checkpoint was taken of, with the same search options (see Checkpoint::matches)
+		// The limits and schedule should be those of the original search, though the node budget and deadline may be new
+		Solver(shared_ptr<T> initialConfig, const Checkpoint& resume, const SolverLimits& limits = SolverLimits(), const RestartSchedule& schedule = RestartSchedule()) : 
+			Solver(initialConfig, limits, schedule, nullptr, &resume) {}
+	
 	public:
 		bool isFailure() const {
 			return m_failure;
 		}
 		
-		int numDeadEnds() const {
-			return m_deadEnds;
+		// How the solve ended; anything but Solved is also a failure
+		SolveStatus status() const {
+			return m_status;
+		}
+		
+		// The number of attempts abandoned by the restart schedule
+		int numRestarts() const {
+			return m_restarts;
+		}
+		
+		long numNodes() const {
+			return m_nodes;
+		}
+		
+		// Zero unless the statistics policy counts them
+		long numDeadEnds() const {
+			return m_stats.deadEnds();
 		}
 		
 		int maxDepth() const {
-			return m_maxDepth;
+			return m_stats.maxDepth();
+		}
+		
+		// Everything the statistics policy collected
+		const Stats& stats() const {
+			return m_stats;
+		}
+		
+		// Wall-clock time the solve took, up to wherever it stopped
+		double elapsedMs() const {
+			return m_elapsedMs;
 		}
 		
 		const vector<shared_ptr<T>>& getSolutionPath() const {
 			return m_path;
 		}
 		
+		// The number of checkpoints written
+		long numCheckpoints() const {
+			return m_checkpoints;
+		}
+		
 };
+
+#endif
@@ -0,0 +1,460 @@
+/**
+  * SolverDaemon.cpp
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This is an implementation of SolverDaemon.h.
+  * 		 For an explanation of the class, please consult that file.
+  */
+
+#include "Cell.h"
+#include "KakuroConfig.h"
+#include "PuzzleCheck.h"
+#include "SolutionCache.h"
+#include "Solver.h"
+#include "SolverDaemon.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+const array<double, 12> SolverDaemon::latencyBounds {{1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000}};
+
+// The most cells a request's board may have, so a bad header can't make us allocate without end
+static const long maxCells = 1 << 20;
+
+// Reads a line (without its newline) from a socket, keeping whatever came after it in buffer
+static bool readLine(int fd, string& buffer, string& line) {
+	size_t end;
+	
+	while((end = buffer.find('\n')) == string::npos) {
+		char chunk[4096];
+		ssize_t got = read(fd, chunk, sizeof(chunk));
+		if(got <= 0) return false;
+		
+		buffer.append(chunk, got);
+	}
+	
+	line = buffer.substr(0, end);
+	buffer.erase(0, end + 1);
+	
+	if(!line.empty() && line.back() == '\r') line.pop_back();
+	
+	return true;
+}
+
+static bool writeAll(int fd, const string& data) {
+	size_t done(0);
+	
+	while(done < data.size()) {
+		// A client that hung up mustn't take the daemon down with a SIGPIPE
+		ssize_t written = send(fd, data.data() + done, data.size() - done, MSG_NOSIGNAL);
+		if(written <= 0) return false;
+		
+		done += written;
+	}
+	
+	return true;
+}
+
+// A solve of one board, given to withSizedConfig so standard sizes get their fixed-size config
+struct SizedSolve {
+	const SolverLimits& limits;
+	
+	// Filled in by the solve
+	SolveStatus status;
+	long nodes, deadEnds;
+	double ms;
+	vector<vector<Cell>> solution;
+	
+	template <class Config>
+	void operator()(shared_ptr<Config> config) {
+		Solver<Config> solver(config, limits);
+		
+		status = solver.status();
+		nodes = solver.numNodes();
+		deadEnds = solver.numDeadEnds();
+		ms = solver.elapsedMs();
+		
+		if(status == SolveStatus::Solved) solution = solver.getSolutionPath().front()->getBoard();
+	}
+};
+
+SolverDaemon::SolverDaemon(const string& socketPath, unsigned threads, SolutionCache* cache) :
+	m_socketPath(socketPath), m_numThreads(threads > 0 ? threads : max(1u, thread::hardware_concurrency())), m_batchSize(16),
+	m_cache(cache), m_cacheMutex(), m_listenFd(-1), m_mutex(), m_ready(), m_queue(), m_stopping(false), m_workers(), m_connections(), m_connectionFds(), m_finished(),
+	m_started(chrono::steady_clock::now()), m_requests(0), m_solved(0), m_unsolvable(0), m_stopped(0), m_errors(0), m_cached(0), m_batches(0), m_inFlight(0) {
+	for(atomic<long>& bucket : m_latency) bucket = 0;
+}
+
+SolverDaemon::~SolverDaemon() {
+	if(m_listenFd != -1) {
+		close(m_listenFd);
+		unlink(m_socketPath.c_str());
+	}
+}
+
+bool SolverDaemon::run() {
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	
+	if(m_socketPath.size() >= sizeof(address.sun_path)) {
+		cerr << "Socket path too long: " << m_socketPath << endl;
+		return false;
+	}
+	
+	strcpy(address.sun_path, m_socketPath.c_str());
+	
+	// A socket file left behind by a daemon that died would make bind fail
+	unlink(m_socketPath.c_str());
+	
+	m_listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+	
+	if(m_listenFd == -1 || bind(m_listenFd, (sockaddr*)&address, sizeof(address)) != 0 || listen(m_listenFd, 64) != 0) {
+		cerr << "Couldn't listen on " << m_socketPath << ": " << strerror(errno) << endl;
+		return false;
+	}
+	
+	for(unsigned k = 0; k < m_numThreads; ++k) {
+		m_workers.push_back(thread(&SolverDaemon::workerLoop, this));
+	}
+	
+	cerr << "Listening on " << m_socketPath << " with " << m_numThreads << " workers" << endl;
+	
+	while(true) {
+		int fd = accept(m_listenFd, nullptr, nullptr);
+		
+		lock_guard<mutex> lock(m_mutex);
+		reapConnections();
+		
+		if(m_stopping) {
+			if(fd != -1) close(fd);
+			break;
+		}
+		
+		if(fd == -1) continue;
+		
+		// Connections are cheap to wait on; the work itself happens on the pool
+		// The thread can't register itself before it has the lock, which we hold until it's registered
+		m_connections.push_back(thread(&SolverDaemon::serve, this, fd));
+		m_connectionFds[m_connections.back().get_id()] = fd;
+	}
+	
+	// The workers answer everything queued first, so no connection is left waiting on a response
+	for(thread& worker : m_workers) worker.join();
+	
+	// Then the connections still open are woken from their reads and joined, so none outlives us
+	{
+		lock_guard<mutex> lock(m_mutex);
+		for(const pair<const thread::id, int>& connection : m_connectionFds) shutdown(connection.second, SHUT_RDWR);
+	}
+	
+	for(thread& connection : m_connections) connection.join();
+	
+	m_connections.clear();
+	m_connectionFds.clear();
+	m_finished.clear();
+	
+	return true;
+}
+
+void SolverDaemon::serve(int fd) {
+	string buffer, line;
+	
+	while(readLine(fd, buffer, line)) {
+		istringstream command(line);
+		string verb;
+		command >> verb;
+		
+		if(verb.empty()) continue;
+		
+		string response;
+		
+		if(verb == "SOLVE") {
+			long timeoutMs(0);
+			command >> timeoutMs;
+			
+			// The puzzle is the next 2 + rows * columns tokens, however they're split over lines
+			string puzzle;
+			long need(-1), have(0);
+			bool ok(true);
+			
+			while(need < 0 || have < need) {
+				if(!readLine(fd, buffer, line)) {
+					ok = false;
+					break;
+				}
+				
+				istringstream tokens(line);
+				string token;
+				while(tokens >> token) {
+					++have;
+					
+					if(have == 2) {
+						istringstream dims(puzzle + " " + token);
+						long rows(0), cols(0);
+						dims >> rows >> cols;
+						
+						need = (rows > 0 && cols > 0 && rows * cols <= maxCells) ? 2 + rows * cols : 0;
+					}
+					
+					puzzle += token + " ";
+				}
+				
+				if(need == 0) break;
+			}
+			
+			if(!ok) break;
+			
+			++m_requests;
+			
+			istringstream input(puzzle);
+			shared_ptr<Job> job = make_shared<Job>();
+			job->board = (need > 0) ? KakuroConfig::readBoard(input) : vector<vector<Cell>>();
+			job->timeoutMs = timeoutMs;
+			job->queued = chrono::steady_clock::now();
+			
+			vector<PuzzleProblem> problems = job->board.empty() ? vector<PuzzleProblem>() : checkPuzzle(job->board);
+			
+			if(job->board.empty()) {
+				++m_errors;
+				response = "ERROR unreadable puzzle\n";
+			} else if(!problems.empty()) {
+				// Clues that can't add up are answered here, without taking up a worker
+				++m_errors;
+				response = "ERROR invalid puzzle: " + describeProblem(problems.front()) + "\n";
+			} else {
+				future<string> result = job->response.get_future();
+				bool queued(false);
+				
+				{
+					// Once we're stopping, the workers may already be gone
+					lock_guard<mutex> lock(m_mutex);
+					
+					if(!m_stopping) {
+						m_queue.push_back(job);
+						queued = true;
+					}
+				}
+				
+				if(queued) {
+					m_ready.notify_one();
+					response = result.get();
+				} else {
+					++m_errors;
+					response = "ERROR shutting down\n";
+				}
+			}
+		} else if(verb == "METRICS") {
+			response = metrics();
+		} else if(verb == "SHUTDOWN") {
+			{
+				lock_guard<mutex> lock(m_mutex);
+				m_stopping = true;
+			}
+			
+			m_ready.notify_all();
+			
+			// Wakes the accept loop up so it can see we're stopping
+			shutdown(m_listenFd, SHUT_RDWR);
+			
+			response = "OK\n";
+		} else {
+			response = "ERROR unknown request " + verb + "\n";
+		}
+		
+		// A blank line ends every response
+		if(!writeAll(fd, response + "\n")) break;
+	}
+	
+	// The socket is forgotten before it's closed, so stopping never shuts down a descriptor that's been reused
+	lock_guard<mutex> lock(m_mutex);
+	
+	m_connectionFds.erase(this_thread::get_id());
+	m_finished.push_back(this_thread::get_id());
+	
+	close(fd);
+}
+
+void SolverDaemon::reapConnections() {
+	for(const thread::id& id : m_finished) {
+		auto it = find_if(m_connections.begin(), m_connections.end(), [&id](const thread& connection) { return connection.get_id() == id; });
+		
+		// It has nothing left to do but return
+		if(it != m_connections.end()) {
+			it->join();
+			m_connections.erase(it);
+		}
+	}
+	
+	m_finished.clear();
+}
+
+void SolverDaemon::workerLoop() {
+	while(true) {
+		vector<shared_ptr<Job>> batch;
+		
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_ready.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+			
+			if(m_queue.empty()) return;
+			
+			// Take a fair share of what's waiting (up to a batch) in one go, so a burst costs each worker one trip through the lock
+			size_t share = min<size_t>(m_batchSize, max<size_t>(1, m_queue.size() / m_numThreads));
+			
+			while(!m_queue.empty() && batch.size() < share) {
+				batch.push_back(m_queue.front());
+				m_queue.pop_front();
+			}
+		}
+		
+		++m_batches;
+		m_inFlight += batch.size();
+		
+		// Puzzles sent more than once in a batch are solved once
+		map<string, string> answered;
+		
+		for(shared_ptr<Job>& job : batch) {
+			ostringstream key;
+			key << job->timeoutMs << endl;
+			KakuroConfig::writeBoard(key, job->board);
+			
+			auto it = answered.find(key.str());
+			string response = (it != answered.end()) ? it->second : solve(*job);
+			
+			// A timed-out answer isn't shared, since a copy queued later has a later deadline
+			if(it == answered.end() && response.compare(0, 7, "TIMEOUT") != 0) answered[key.str()] = response;
+			
+			recordLatency(chrono::duration<double, milli>(chrono::steady_clock::now() - job->queued).count());
+			--m_inFlight;
+			
+			job->response.set_value(response);
+		}
+	}
+}
+
+string SolverDaemon::solve(const Job& job) {
+	double waitMs = chrono::duration<double, milli>(chrono::steady_clock::now() - job.queued).count();
+	ostringstream os;
+	
+	if(m_cache != nullptr) {
+		vector<vector<Cell>> solution;
+		bool hit;
+		
+		{
+			lock_guard<mutex> lock(m_cacheMutex);
+			hit = m_cache->lookup(job.board, solution);
+		}
+		
+		if(hit) {
+			++m_solved;
+			++m_cached;
+			
+			os << "SOLVED cached=1 nodes=0 wait_ms=" << waitMs << " solve_ms=0" << endl;
+			KakuroConfig::writeBoard(os, solution);
+			
+			return os.str();
+		}
+	}
+	
+	// The timeout runs from when the request was queued, so the wait behind the rest of its batch counts against it
+	SolverLimits limits;
+	
+	if(job.timeoutMs > 0) {
+		limits.hasDeadline = true;
+		limits.deadline = job.queued + chrono::milliseconds(job.timeoutMs);
+		
+		if(chrono::steady_clock::now() >= limits.deadline) {
+			++m_stopped;
+			os << "TIMEOUT nodes=0 dead_ends=0 wait_ms=" << to_string(waitMs) << " solve_ms=0" << endl;
+			
+			return os.str();
+		}
+	}
+	
+	SizedSolve solver{limits, SolveStatus::Unsolvable, 0, 0, 0, vector<vector<Cell>>()};
+	withSizedConfig(job.board, false, solver);
+	
+	string stats = " nodes=" + to_string(solver.nodes) + " dead_ends=" + to_string(solver.deadEnds) + " wait_ms=" + to_string(waitMs) + " solve_ms=" + to_string(solver.ms);
+	
+	if(solver.status == SolveStatus::Solved) {
+		++m_solved;
+		
+		if(m_cache != nullptr) {
+			lock_guard<mutex> lock(m_cacheMutex);
+			m_cache->store(job.board, solver.solution);
+		}
+		
+		os << "SOLVED cached=0" << stats << endl;
+		KakuroConfig::writeBoard(os, solver.solution);
+	} else if(solver.status == SolveStatus::Unsolvable) {
+		++m_unsolvable;
+		os << "UNSOLVABLE" << stats << endl;
+	} else {
+		++m_stopped;
+		os << "TIMEOUT" << stats << endl;
+	}
+	
+	return os.str();
+}
+
+void SolverDaemon::recordLatency(double ms) {
+	unsigned bucket(0);
+	while(bucket < latencyBounds.size() && ms > latencyBounds[bucket]) ++bucket;
+	
+	++m_latency[bucket];
+}
+
+string SolverDaemon::metrics() {
+	double uptime = chrono::duration<double>(chrono::steady_clock::now() - m_started).count();
+	size_t queued;
+	
+	{
+		lock_guard<mutex> lock(m_mutex);
+		queued = m_queue.size();
+	}
+	
+	ostringstream os;
+	os << fixed << setprecision(3);
+	
+	os << "uptime_s " << uptime << endl;
+	os << "requests " << m_requests << endl;
+	os << "solved " << m_solved << endl;
+	os << "cached " << m_cached << endl;
+	os << "unsolvable " << m_unsolvable << endl;
+	os << "timed_out " << m_stopped << endl;
+	os << "errors " << m_errors << endl;
+	os << "batches " << m_batches << endl;
+	os << "queue_depth " << queued << endl;
+	os << "in_flight " << m_inFlight << endl;
+	os << "throughput_rps " << (uptime > 0 ? m_requests / uptime : 0) << endl;
+	
+	// Cumulative, like Prometheus histograms
+	long total(0);
+	for(unsigned k = 0; k < m_latency.size(); ++k) {
+		total += m_latency[k];
+		
+		if(k < latencyBounds.size()) {
+			os << "latency_ms_le_" << long(latencyBounds[k]) << " " << total << endl;
+		} else {
+			os << "latency_ms_le_inf " << total << endl;
+		}
+	}
+	
+	return os.str();
+}
@@ -0,0 +1,113 @@
+/**
+  * SolverDaemon.h
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This class is a long-running solver service listening on a Unix domain socket.
+  *		 Clients send requests as lines of text; a connection can send any number of them in turn, and each gets a response ending with a blank line.
+  *		 "SOLVE [timeout ms]" followed by a puzzle in the usual input format answers with a status line (with the request's stats) and the solved board.
+  *		 The timeout counts from when the request is queued, so a request that waited it out is answered "TIMEOUT" without being searched.
+  *		 Puzzles whose clues can't add up (see PuzzleCheck.h) are answered with an error naming the problem, without being queued.
+  *		 "METRICS" answers with counters, the queue depth, throughput and a latency histogram, one "name value" line each.
+  *		 "SHUTDOWN" stops the daemon once the queued requests are answered.
+  *		 Requests are queued and taken off in batches by a pool of worker threads; identical puzzles in a batch are solved once.
+  *		 The process stays up between requests, so the partitioner's caches (and the solution cache, if there is one) stay warm.
+  */
+
+#ifndef KDAEMON_H
+#define KDAEMON_H
+
+#include "Cell.h"
+#include "SolutionCache.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class SolverDaemon {
+	private:
+		// A solve request waiting for a worker
+		struct Job {
+			std::vector<std::vector<Cell>> board;
+			long timeoutMs;
+			std::chrono::steady_clock::time_point queued;
+			std::promise<std::string> response;
+		};
+		
+		// Upper bounds (in milliseconds) of the latency histogram's buckets; the last bucket takes everything slower
+		static const std::array<double, 12> latencyBounds;
+		
+		std::string m_socketPath;
+		unsigned m_numThreads;
+		unsigned m_batchSize;
+		
+		// Looked up before solving and filled in after, if given; it isn't thread-safe, so it has its own lock
+		SolutionCache* m_cache;
+		std::mutex m_cacheMutex;
+		
+		int m_listenFd;
+		
+		std::mutex m_mutex;
+		std::condition_variable m_ready;
+		std::deque<std::shared_ptr<Job>> m_queue;
+		bool m_stopping;
+		
+		std::vector<std::thread> m_workers;
+		
+		// One thread per open connection and its socket, so they can be shut down and joined on stopping, and the threads that have finished, to be joined on the next accept
+		// All three are guarded by m_mutex
+		std::list<std::thread> m_connections;
+		std::map<std::thread::id, int> m_connectionFds;
+		std::vector<std::thread::id> m_finished;
+		
+		// Metrics
+		std::chrono::steady_clock::time_point m_started;
+		std::atomic<long> m_requests, m_solved, m_unsolvable, m_stopped, m_errors, m_cached, m_batches, m_inFlight;
+		std::array<std::atomic<long>, 13> m_latency;
+	
+	private:
+		// Reads requests from a connection and writes their responses until the client hangs up
+		void serve(int fd);
+		
+		// Joins the connection threads that have finished; called with m_mutex held
+		void reapConnections();
+		
+		// Takes batches off the queue and answers them until the daemon stops and the queue is empty
+		void workerLoop();
+		
+		// Solves one puzzle (or looks it up), returning the response to send
+		std::string solve(const Job& job);
+		
+		// Counts a finished request's latency
+		void recordLatency(double ms);
+		
+		std::string metrics();
+	
+	public:
+		// threads is the number of workers (0 for one per core); cache may be null
+		SolverDaemon(const std::string& socketPath, unsigned threads, SolutionCache* cache);
+		~SolverDaemon();
+		
+		// Disable copy construction
+		SolverDaemon(const SolverDaemon& other) = delete;
+		
+		// Disable assignment
+		void operator=(const SolverDaemon& other) = delete;
+	
+	public:
+		// Listens and serves until a client asks to shut down; returns false if the socket couldn't be set up
+		bool run();
+};
+
+#endif
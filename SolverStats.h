@@ -0,0 +1,151 @@
+/**
+  * SolverStats.h
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: These are the statistics policies the solver is parameterized on.
+  *		 The solver calls the same hooks on every policy; NoStats does nothing with them, so they compile away.
+  *		 CountingStats counts dead ends, backtracks, branching and depth, and TimingStats adds cycle counts for expanding nodes.
+  *		 Each policy can print itself as tab-separated columns, under the names given by columns().
+  */
+
+#ifndef KSTATS_H
+#define KSTATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Collects nothing; for solves where every cycle counts
+class NoStats {
+	public:
+		// Hooks for entering a node, finding a dead end, coming back from a failed child and branching into children
+		void onNode(int) {}
+		void onDeadEnd() {}
+		void onBacktrack() {}
+		void onBranch(int) {}
+		
+		// Hooks around generating a node's successors; whatever begin returns is handed to end
+		std::uint64_t beginExpand() { return 0; }
+		void endExpand(std::uint64_t) {}
+		
+		// Folds in the statistics of a sub-solver whose root was at the given depth
+		void merge(const NoStats&, int) {}
+		
+		long deadEnds() const { return 0; }
+		int maxDepth() const { return 0; }
+		
+		static std::string columns() { return ""; }
+		void print(std::ostream&) const {}
+};
+
+// Counts what the search did
+class CountingStats {
+	protected:
+		long m_deadEnds;
+		long m_backtracks;
+		
+		// Nodes that were branched on and the children they had between them
+		long m_branched;
+		long m_children;
+		
+		int m_maxDepth;
+	
+	public:
+		CountingStats() : m_deadEnds(0), m_backtracks(0), m_branched(0), m_children(0), m_maxDepth(0) {}
+		
+		void onNode(int depth) {
+			if(depth > m_maxDepth) m_maxDepth = depth;
+		}
+		
+		void onDeadEnd() {
+			++m_deadEnds;
+		}
+		
+		void onBacktrack() {
+			++m_backtracks;
+		}
+		
+		void onBranch(int children) {
+			++m_branched;
+			m_children += children;
+		}
+		
+		std::uint64_t beginExpand() { return 0; }
+		void endExpand(std::uint64_t) {}
+		
+		void merge(const CountingStats& other, int depth) {
+			m_deadEnds += other.m_deadEnds;
+			m_backtracks += other.m_backtracks;
+			m_branched += other.m_branched;
+			m_children += other.m_children;
+			if(depth + other.m_maxDepth > m_maxDepth) m_maxDepth = depth + other.m_maxDepth;
+		}
+		
+		long deadEnds() const {
+			return m_deadEnds;
+		}
+		
+		int maxDepth() const {
+			return m_maxDepth;
+		}
+		
+		static std::string columns() {
+			return "dead ends\tbacktracks\tbranching\tmax depth";
+		}
+		
+		void print(std::ostream& os) const {
+			os << m_deadEnds << "\t" << m_backtracks << "\t" << (m_branched > 0 ? double(m_children) / m_branched : 0) << "\t" << m_maxDepth;
+		}
+};
+
+// Counts what the search did and how many cycles went into expanding nodes (generating successors and propagating)
+class TimingStats : public CountingStats {
+	private:
+		std::uint64_t m_expandCycles;
+		long m_expansions;
+	
+	public:
+		TimingStats() : CountingStats(), m_expandCycles(0), m_expansions(0) {}
+		
+		// The CPU's cycle counter where there is one, and nanoseconds of the steady clock otherwise
+		static std::uint64_t cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+			return __rdtsc();
+#else
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+		}
+		
+		std::uint64_t beginExpand() {
+			return cycles();
+		}
+		
+		void endExpand(std::uint64_t start) {
+			m_expandCycles += cycles() - start;
+			++m_expansions;
+		}
+		
+		void merge(const TimingStats& other, int depth) {
+			CountingStats::merge(other, depth);
+			m_expandCycles += other.m_expandCycles;
+			m_expansions += other.m_expansions;
+		}
+		
+		static std::string columns() {
+			return CountingStats::columns() + "\texpand cycles\tcycles/expand";
+		}
+		
+		void print(std::ostream& os) const {
+			CountingStats::print(os);
+			os << "\t" << m_expandCycles << "\t" << (m_expansions > 0 ? m_expandCycles / m_expansions : 0);
+		}
+};
+
+#endif
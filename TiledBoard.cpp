@@ -0,0 +1,94 @@
+/**
+  * TiledBoard.cpp
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This is an implementation of TiledBoard.h.
+  * 		 For an explanation of the class, please consult that file.
+  */
+
+#include "Cell.h"
+#include "TiledBoard.h"
+
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+TiledBoard::TiledBoard() : m_height(0), m_width(0), m_tilesAcross(0), m_tiles() {}
+
+TiledBoard::TiledBoard(const vector<vector<Cell>>& board) :
+	m_height(board.size()), m_width(board.empty() ? 0 : board[0].size()), m_tilesAcross((m_width + tileSide - 1) / tileSide), m_tiles() {
+	unsigned tilesDown = (m_height + tileSide - 1) / tileSide;
+	
+	for(unsigned k = 0; k < tilesDown * m_tilesAcross; ++k) {
+		m_tiles.push_back(make_shared<vector<Cell>>(tileSide * tileSide, Cell(0, 0)));
+	}
+	
+	for(unsigned i = 0; i < m_height; ++i) {
+		for(unsigned j = 0; j < m_width; ++j) {
+			(*m_tiles[tileOf(i, j)])[offsetOf(i, j)] = board[i][j];
+		}
+	}
+}
+
+unsigned TiledBoard::tileOf(unsigned row, unsigned col) const {
+	return (row / tileSide) * m_tilesAcross + col / tileSide;
+}
+
+unsigned TiledBoard::offsetOf(unsigned row, unsigned col) const {
+	return (row % tileSide) * tileSide + col % tileSide;
+}
+
+unsigned TiledBoard::height() const {
+	return m_height;
+}
+
+unsigned TiledBoard::width() const {
+	return m_width;
+}
+
+bool TiledBoard::empty() const {
+	return m_height == 0;
+}
+
+const Cell& TiledBoard::at(unsigned row, unsigned col) const {
+	return (*m_tiles[tileOf(row, col)])[offsetOf(row, col)];
+}
+
+Cell& TiledBoard::edit(unsigned row, unsigned col) {
+	shared_ptr<vector<Cell>>& tile = m_tiles[tileOf(row, col)];
+	
+	// If we're the only holder no one else can be reading it, so it's ours to write
+	if(tile.use_count() > 1) tile = make_shared<vector<Cell>>(*tile);
+	
+	return (*tile)[offsetOf(row, col)];
+}
+
+unsigned TiledBoard::numTiles() const {
+	return m_tiles.size();
+}
+
+unsigned TiledBoard::numOwnedTiles() const {
+	unsigned owned(0);
+	
+	for(const shared_ptr<vector<Cell>>& tile : m_tiles) {
+		if(tile.use_count() == 1) ++owned;
+	}
+	
+	return owned;
+}
+
+vector<vector<Cell>> TiledBoard::toRows() const {
+	vector<vector<Cell>> rows;
+	
+	for(unsigned i = 0; i < m_height; ++i) {
+		vector<Cell> row;
+		for(unsigned j = 0; j < m_width; ++j) row.push_back(at(i, j));
+		
+		rows.push_back(row);
+	}
+	
+	return rows;
+}
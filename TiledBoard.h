@@ -0,0 +1,66 @@
+/**
+  * TiledBoard.h
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This class is a board of cells stored as square tiles that copies share until one of them writes.
+  *		 Copying a board only copies its list of tiles; a tile is duplicated the first time a copy changes one of its cells while another board still holds it.
+  *		 A successor config changes the cell it fills and the possible values along that cell's runs, so it owns only the few tiles those touch and shares the rest with its parent.
+  *		 Only a board no other board shares a tile with writes that tile in place, so boards in different threads never write the same tile.
+  */
+
+#ifndef KTILES_H
+#define KTILES_H
+
+#include "Cell.h"
+
+#include <memory>
+#include <vector>
+
+class TiledBoard {
+	public:
+		// The number of cells along each side of a tile
+		static const unsigned tileSide = 4;
+	
+	private:
+		unsigned m_height, m_width;
+		
+		// The number of tiles in a row of tiles
+		unsigned m_tilesAcross;
+		
+		// Tiles in row-major order, each holding its cells in row-major order (tiles past the board's edge are padded with sum cells)
+		std::vector<std::shared_ptr<std::vector<Cell>>> m_tiles;
+	
+	public:
+		// Constructor for an empty board
+		TiledBoard();
+		
+		// Constructor for a board holding the given cells
+		explicit TiledBoard(const std::vector<std::vector<Cell>>& board);
+	
+	private:
+		// The tile holding a cell, and the cell's position in it
+		unsigned tileOf(unsigned row, unsigned col) const;
+		unsigned offsetOf(unsigned row, unsigned col) const;
+	
+	public:
+		unsigned height() const;
+		unsigned width() const;
+		bool empty() const;
+		
+		// The cell at a position
+		const Cell& at(unsigned row, unsigned col) const;
+		
+		// The cell at a position, to be changed; its tile is copied first if another board shares it
+		Cell& edit(unsigned row, unsigned col);
+		
+		// The number of tiles, and how many of them no other board shares
+		unsigned numTiles() const;
+		unsigned numOwnedTiles() const;
+		
+		// The cells as rows
+		std::vector<std::vector<Cell>> toRows() const;
+};
+
+#endif
@@ -0,0 +1,156 @@
+/**
+  * TiledVector.h
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This class is a list of values stored as fixed-size tiles that copies share until one of them writes, as TiledBoard does for cells.
+  *		 Copying a list only copies its list of tiles; a tile is duplicated the first time a copy changes one of its values while another list still holds it.
+  *		 A config keeps its per-run totals, its buckets of cells and each cell's place in them this way, so a successor owns only the tiles its assignment touched.
+  *		 Values are read with [] and changed through edit, so a read never copies a tile.
+  */
+
+#ifndef KTILEDVECTOR_H
+#define KTILEDVECTOR_H
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+template <class T>
+class TiledVector {
+	public:
+		// The number of values in a tile
+		static const unsigned tileSize = 32;
+		
+		typedef std::array<T, tileSize> Tile;
+		
+		// Walks the values in order, for reading only
+		class const_iterator {
+			private:
+				// The list walked
+				const TiledVector* m_list;
+				
+				// The index of the current value
+				unsigned m_index;
+			
+			public:
+				typedef std::forward_iterator_tag iterator_category;
+				typedef T value_type;
+				typedef std::ptrdiff_t difference_type;
+				typedef const T* pointer;
+				typedef const T& reference;
+				
+				const_iterator() : m_list(nullptr), m_index(0) {}
+				const_iterator(const TiledVector* list, unsigned index) : m_list(list), m_index(index) {}
+				
+				const T& operator*() const {
+					return (*m_list)[m_index];
+				}
+				
+				const T* operator->() const {
+					return &(*m_list)[m_index];
+				}
+				
+				const_iterator& operator++() {
+					++m_index;
+					return *this;
+				}
+				
+				const_iterator operator++(int) {
+					const_iterator old(*this);
+					++m_index;
+					return old;
+				}
+				
+				bool operator==(const const_iterator& other) const {
+					return m_index == other.m_index;
+				}
+				
+				bool operator!=(const const_iterator& other) const {
+					return m_index != other.m_index;
+				}
+		};
+	
+	private:
+		// The number of values in use
+		unsigned m_size;
+		
+		// Tiles in order; the last may be partly used, and values past the size are left over from removals
+		std::vector<std::shared_ptr<Tile>> m_tiles;
+	
+	public:
+		// Constructor for an empty list
+		TiledVector() : m_size(0), m_tiles() {}
+		
+		// Constructor for a list of size copies of a value
+		TiledVector(unsigned size, const T& value) : m_size(size), m_tiles() {
+			for(unsigned k = 0; k < (size + tileSize - 1) / tileSize; ++k) {
+				m_tiles.push_back(std::make_shared<Tile>());
+				m_tiles.back()->fill(value);
+			}
+		}
+	
+	public:
+		unsigned size() const {
+			return m_size;
+		}
+		
+		bool empty() const {
+			return m_size == 0;
+		}
+		
+		const T& operator[](unsigned index) const {
+			return (*m_tiles[index / tileSize])[index % tileSize];
+		}
+		
+		const T& front() const {
+			return (*this)[0];
+		}
+		
+		const T& back() const {
+			return (*this)[m_size - 1];
+		}
+		
+		// The value at an index, to be changed; its tile is copied first if another list shares it
+		T& edit(unsigned index) {
+			std::shared_ptr<Tile>& tile = m_tiles[index / tileSize];
+			
+			// If we're the only holder no one else can be reading it, so it's ours to write
+			if(tile.use_count() > 1) tile = std::make_shared<Tile>(*tile);
+			
+			return (*tile)[index % tileSize];
+		}
+		
+		void push_back(const T& value) {
+			if(m_size == m_tiles.size() * tileSize) m_tiles.push_back(std::make_shared<Tile>());
+			
+			edit(m_size++) = value;
+		}
+		
+		// A tile left empty is let go rather than written to
+		void pop_back() {
+			--m_size;
+			if(m_size % tileSize == 0) m_tiles.pop_back();
+		}
+		
+		void clear() {
+			m_size = 0;
+			m_tiles.clear();
+		}
+		
+		const_iterator begin() const {
+			return const_iterator(this, 0);
+		}
+		
+		const_iterator end() const {
+			return const_iterator(this, m_size);
+		}
+};
+
+template <class T>
+const unsigned TiledVector<T>::tileSize;
+
+#endif
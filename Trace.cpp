@@ -0,0 +1,257 @@
+/**
+  * Trace.cpp
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This is an implementation of Trace.h.
+  * 		 For an explanation of the class, please consult that file.
+  */
+
+#include "Trace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Trace files start with this, followed by the format version and the record size
+static const char traceMagic[4] = {'K', 'T', 'R', 'C'};
+static const uint32_t traceVersion = 1;
+
+atomic<bool> Tracer::s_enabled(false);
+
+Tracer::Tracer() : m_mutex(), m_generation(0), m_buffers(), m_retired(), m_file(nullptr), m_flusher(), m_running(false), m_start(), m_dropped(0) {}
+
+Tracer::~Tracer() {
+	stop();
+}
+
+Tracer::RingBuffer& Tracer::localBuffer() {
+	// Cached per thread, and only trusted for the session it was registered in
+	thread_local RingBuffer* buffer(nullptr);
+	thread_local unsigned generation(0);
+	
+	unsigned current = m_generation.load(memory_order_acquire);
+	
+	if(buffer == nullptr || generation != current) {
+		lock_guard<mutex> lock(m_mutex);
+		
+		m_buffers.push_back(make_shared<RingBuffer>(m_buffers.size()));
+		buffer = m_buffers.back().get();
+		generation = current;
+	}
+	
+	return *buffer;
+}
+
+void Tracer::record(TraceEvent event, int cell, int value, int depth, int domain) {
+	RingBuffer& buffer = localBuffer();
+	
+	uint64_t head = buffer.head.load(memory_order_relaxed);
+	
+	// Rather than wait on the flusher, drop the event and say so in the report
+	if(head - buffer.tail.load(memory_order_acquire) >= RingBuffer::capacity) {
+		m_dropped.fetch_add(1, memory_order_relaxed);
+		return;
+	}
+	
+	TraceRecord& r = buffer.records[head % RingBuffer::capacity];
+	r.time = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - m_start).count();
+	r.cell = cell;
+	r.value = value;
+	r.event = uint8_t(event);
+	r.depth = min(depth, 0xFFFF);
+	r.domain = min(domain, 0xFFFF);
+	r.thread = buffer.thread;
+	
+	buffer.head.store(head + 1, memory_order_release);
+}
+
+void Tracer::drain() {
+	vector<shared_ptr<RingBuffer>> buffers;
+	
+	{
+		lock_guard<mutex> lock(m_mutex);
+		buffers = m_buffers;
+	}
+	
+	for(shared_ptr<RingBuffer>& buffer : buffers) {
+		uint64_t tail = buffer->tail.load(memory_order_relaxed);
+		uint64_t head = buffer->head.load(memory_order_acquire);
+		
+		// The ready records may wrap around the end of the buffer, so write them in at most two pieces
+		while(tail < head) {
+			unsigned from = tail % RingBuffer::capacity;
+			unsigned count = min<uint64_t>(head - tail, RingBuffer::capacity - from);
+			
+			fwrite(&buffer->records[from], sizeof(TraceRecord), count, m_file);
+			tail += count;
+		}
+		
+		buffer->tail.store(tail, memory_order_release);
+	}
+}
+
+void Tracer::flushLoop() {
+	while(m_running.load()) {
+		drain();
+		this_thread::sleep_for(chrono::milliseconds(2));
+	}
+}
+
+bool Tracer::start(const string& filename) {
+	stop();
+	
+	m_file = fopen(filename.c_str(), "wb");
+	if(m_file == nullptr) return false;
+	
+	uint32_t header[2] = {traceVersion, uint32_t(sizeof(TraceRecord))};
+	fwrite(traceMagic, 1, sizeof(traceMagic), m_file);
+	fwrite(header, sizeof(uint32_t), 2, m_file);
+	
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_retired.insert(m_retired.end(), m_buffers.begin(), m_buffers.end());
+		m_buffers.clear();
+	}
+	
+	m_dropped = 0;
+	m_start = chrono::steady_clock::now();
+	++m_generation;
+	
+	m_running = true;
+	m_flusher = thread(&Tracer::flushLoop, this);
+	
+	s_enabled = true;
+	
+	return true;
+}
+
+void Tracer::stop() {
+	if(m_file == nullptr) return;
+	
+	s_enabled = false;
+	
+	m_running = false;
+	m_flusher.join();
+	
+	// Whatever was recorded after the flusher's last pass
+	drain();
+	
+	fclose(m_file);
+	m_file = nullptr;
+}
+
+long Tracer::dropped() const {
+	return m_dropped.load();
+}
+
+bool traceReport(const string& filename, ostream& os, int maxDepth) {
+	FILE* file = fopen(filename.c_str(), "rb");
+	if(file == nullptr) return false;
+	
+	char magic[4];
+	uint32_t header[2];
+	
+	if(fread(magic, 1, sizeof(magic), file) != sizeof(magic) || memcmp(magic, traceMagic, sizeof(magic)) != 0 ||
+		fread(header, sizeof(uint32_t), 2, file) != 2 || header[0] != traceVersion || header[1] != sizeof(TraceRecord)) {
+		fclose(file);
+		return false;
+	}
+	
+	vector<TraceRecord> records;
+	TraceRecord r;
+	while(fread(&r, sizeof(r), 1, file) == 1) records.push_back(r);
+	
+	fclose(file);
+	
+	// Each thread's records are in order within the file, but threads are interleaved in flush-sized chunks
+	stable_sort(records.begin(), records.end(), [](const TraceRecord& a, const TraceRecord& b) { return a.thread < b.thread; });
+	
+	struct DepthStats {
+		long events[4];
+		long children;
+		uint64_t ns;
+	};
+	
+	vector<DepthStats> depths;
+	map<string, uint64_t> folded;
+	
+	// Replay each thread's events with a stack of the cells branched on, charging the time until the next event to the top of the stack
+	vector<string> stack;
+	
+	// Whether the node open at each depth has yet to report its children
+	vector<bool> counted;
+	
+	for(unsigned k = 0; k < records.size(); ++k) {
+		const TraceRecord& rec = records[k];
+		
+		if(k == 0 || rec.thread != records[k - 1].thread) {
+			stack.clear();
+			counted.clear();
+		}
+		
+		if(rec.depth >= counted.size()) counted.resize(rec.depth + 1, true);
+		
+		if(rec.depth >= depths.size()) depths.resize(rec.depth + 1, DepthStats{{0, 0, 0, 0}, 0, 0});
+		
+		DepthStats& stats = depths[rec.depth];
+		if(rec.event < 4) ++stats.events[rec.event];
+		
+		if(TraceEvent(rec.event) == TraceEvent::Enter) {
+			stack.resize(rec.depth > 0 ? rec.depth - 1 : 0);
+			stack.push_back(rec.cell < 0 ? string("root") : "cell " + to_string(rec.cell));
+			
+			counted[rec.depth] = false;
+		} else if(TraceEvent(rec.event) == TraceEvent::Assign && !counted[rec.depth]) {
+			// Every child of a node reports the same count, so only count it once
+			stats.children += rec.domain;
+			counted[rec.depth] = true;
+		}
+		
+		if(k + 1 < records.size() && records[k + 1].thread == rec.thread && !stack.empty()) {
+			uint64_t ns = records[k + 1].time - rec.time;
+			stats.ns += ns;
+			
+			string key;
+			for(unsigned f = 0; f < stack.size() && int(f) < maxDepth; ++f) {
+				if(f > 0) key += ";";
+				key += stack[f];
+			}
+			
+			folded[key] += ns;
+		}
+	}
+	
+	long totalNodes(0);
+	for(const DepthStats& stats : depths) totalNodes = max(totalNodes, stats.events[int(TraceEvent::Enter)]);
+	
+	os << records.size() << " events from " << (records.empty() ? 0 : records.back().thread + 1) << " threads" << endl << endl;
+	os << "depth\tnodes\tassigns\tprunes\tbacktracks\tchildren/node\tms\tnodes histogram" << endl;
+	
+	for(unsigned d = 0; d < depths.size(); ++d) {
+		const DepthStats& stats = depths[d];
+		long nodes = stats.events[int(TraceEvent::Enter)];
+		if(nodes == 0 && stats.events[int(TraceEvent::Assign)] == 0) continue;
+		
+		long branched = nodes - stats.events[int(TraceEvent::Prune)];
+		int bar = totalNodes > 0 ? int(40 * nodes / totalNodes) : 0;
+		
+		os << d << "\t" << nodes << "\t" << stats.events[int(TraceEvent::Assign)] << "\t" << stats.events[int(TraceEvent::Prune)] << "\t" << stats.events[int(TraceEvent::Backtrack)] << "\t"
+			<< fixed << setprecision(2) << (branched > 0 ? double(stats.children) / branched : 0) << "\t" << setprecision(3) << stats.ns / 1e6 << "\t" << string(bar, '#') << endl;
+	}
+	
+	// One line per stack with its self time in microseconds, as flame graph tools expect
+	os << endl << "folded stacks (us)" << endl;
+	
+	for(const pair<const string, uint64_t>& stack : folded) {
+		if(stack.second >= 1000) os << stack.first << " " << stack.second / 1000 << endl;
+	}
+	
+	return true;
+}
@@ -0,0 +1,151 @@
+/**
+  * Trace.h
+  *
+  * Author: Lane Lawley
+  * Date: October 19th, 2026
+  *
+  * Description: This class is a singleton that records what the solver does into a binary trace file for offline analysis.
+  *		 Each thread writes fixed-size event records into its own lock-free ring buffer, and a background thread drains the buffers to the file.
+  *		 Events are only recorded between start and stop; otherwise KAKURO_TRACE costs one relaxed atomic load.
+  *		 Building with KAKURO_NO_TRACE defined compiles the tracing out altogether.
+  *		 traceReport turns a trace file into per-depth histograms and folded stacks for flame graph tools.
+  */
+
+#ifndef KTRACE_H
+#define KTRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// What happened at a node of the search
+enum class TraceEvent : std::uint8_t {
+	// The solver entered a node (cell and value are the assignment that led to it)
+	Enter,
+	
+	// The solver is trying a child (domain is how many children the node has)
+	Assign,
+	
+	// The node had no children worth trying
+	Prune,
+	
+	// A child failed and the solver came back to the node
+	Backtrack
+};
+
+// One event as stored in the trace file
+struct TraceRecord {
+	// Nanoseconds since tracing started
+	std::uint64_t time;
+	
+	// The flat cell index (-1 for none) and the value involved
+	std::int32_t cell;
+	std::uint8_t value;
+	
+	std::uint8_t event;
+	std::uint16_t depth;
+	std::uint16_t domain;
+	
+	// The recording thread, numbered in the order threads first recorded
+	std::uint16_t thread;
+};
+
+static_assert(sizeof(TraceRecord) == 24, "trace records are written to disk as they are");
+
+class Tracer {
+	private:
+		// A single-producer, single-consumer queue of records: the owning thread pushes, the flusher pops
+		struct RingBuffer {
+			static const unsigned capacity = 1 << 14;
+			
+			std::vector<TraceRecord> records;
+			std::atomic<std::uint64_t> head;
+			std::atomic<std::uint64_t> tail;
+			std::uint16_t thread;
+			
+			RingBuffer(std::uint16_t thread) : records(capacity), head(0), tail(0), thread(thread) {}
+		};
+		
+		static std::atomic<bool> s_enabled;
+		
+		std::mutex m_mutex;
+		
+		// Bumped on every start so threads know to register a fresh buffer
+		std::atomic<unsigned> m_generation;
+		
+		// Buffers of this session, and those of earlier ones (kept so a thread still writing to one never writes to freed memory)
+		std::vector<std::shared_ptr<RingBuffer>> m_buffers;
+		std::vector<std::shared_ptr<RingBuffer>> m_retired;
+		
+		std::FILE* m_file;
+		std::thread m_flusher;
+		std::atomic<bool> m_running;
+		std::chrono::steady_clock::time_point m_start;
+		
+		// Records lost because a buffer was full
+		std::atomic<long> m_dropped;
+	
+	public:
+		// Singleton accessor for the tracer class
+		static Tracer& getInstance() {
+			static Tracer instance;
+			return instance;
+		}
+		
+		// Whether events are being recorded right now
+		static bool enabled() {
+			return s_enabled.load(std::memory_order_relaxed);
+		}
+	
+	private:
+		Tracer();
+		
+		// Disable copy construction
+		Tracer(const Tracer& other) = delete;
+		
+		// Disable assignment
+		void operator=(const Tracer& other) = delete;
+		
+		// The calling thread's buffer for this session, registering one if need be
+		RingBuffer& localBuffer();
+		
+		// Writes out whatever every buffer holds; only the flusher (or stop, once it's gone) calls this
+		void drain();
+		
+		// The flusher thread's loop
+		void flushLoop();
+	
+	public:
+		~Tracer();
+		
+		// Starts recording into a new trace file; returns false if it couldn't be opened
+		bool start(const std::string& filename);
+		
+		// Stops recording and writes out everything recorded so far
+		void stop();
+		
+		// Records an event from the calling thread
+		void record(TraceEvent event, int cell, int value, int depth, int domain);
+		
+		// Records lost to full buffers since the last start
+		long dropped() const;
+};
+
+// Summarizes a trace file: counts per depth, time per depth, and (up to maxDepth frames) folded stacks of the cells branched on
+// Returns false if the file isn't a trace
+bool traceReport(const std::string& filename, std::ostream& os, int maxDepth);
+
+#ifdef KAKURO_NO_TRACE
+#define KAKURO_TRACE(event, cell, value, depth, domain) do {} while(false)
+#else
+#define KAKURO_TRACE(event, cell, value, depth, domain) do { if(Tracer::enabled()) Tracer::getInstance().record(event, cell, value, depth, domain); } while(false)
+#endif
+
+#endif
@@ -1,12 +1,695 @@
 #include <QApplication>
 
+#include "BatchSolver.h"
+#include "BoardGenerator.h"
+#include "Checkpoint.h"
+#include "KakuroConfig.h"
+#include "Portfolio.h"
+#include "PuzzleCheck.h"
 #include "PuzzleWindow.h"
+#include "SearchContext.h"
+#include "SolutionCache.h"
+#include "Solver.h"
+#include "SolverDaemon.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+using namespace std;
+
+// A short description of how a solve ended
+string statusName(SolveStatus status) {
+	switch(status) {
+		case SolveStatus::Solved: return "solved";
+		case SolveStatus::Unsolvable: return "unsolvable";
+		case SolveStatus::BudgetExceeded: return "budget exceeded";
+		case SolveStatus::Cancelled: return "cancelled";
+	}
+	
+	return "";
+}
+
+// A progress callback that keeps one line of stderr up to date with how far a solve is
+ProgressCallback printProgress(const string& label) {
+	return [label](const SolveProgress& progress) {
+		cerr << "\r" << label << ": " << progress.nodes << " nodes, " << fixed << setprecision(1) << 100 * progress.fraction << "% of about " << scientific << setprecision(2) << progress.estimatedNodes;
+		cerr << defaultfloat << setprecision(6);
+		
+		if(progress.remainingMs >= 0) cerr << ", " << progress.remainingMs / 1000 << " s left";
+		
+		// Clears whatever a longer line before left behind
+		cerr << "          " << flush;
+	};
+}
+
+// One benchmark run of a puzzle, given to withSizedConfig so it's solved with whichever config type suits the puzzle's size
+template <class Stats>
+struct BenchmarkRun {
+	const string& file;
+	const SearchOptions& options;
+	long maxNodes, timeoutMs;
+	const RestartSchedule& schedule;
+	SolutionCache* cache;
+	bool progress;
+	
+	// Filled in by the run
+	long nodes;
+	double ms;
+	
+	template <class Config>
+	void operator()(shared_ptr<Config> config) {
+		if(cache != nullptr) {
+			auto start = chrono::steady_clock::now();
+			vector<vector<Cell>> solution;
+			
+			if(cache->lookup(config->getBoard(), solution)) {
+				ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+				
+				cout << file << "\t" << cellOrderingName(options.cellOrdering) << "\t0\t0\t" << ms << "\tcached" << endl;
+				return;
+			}
+		}
+		
+		config->setSearchOptions(options);
+		
+		SolverLimits limits;
+		limits.maxNodes = maxNodes;
+		if(timeoutMs > 0) limits.setTimeout(timeoutMs);
+		if(progress) limits.progress = printProgress(file);
+		
+		Solver<Config, Stats> solver(config, limits, schedule);
+		if(progress) cerr << endl;
+		nodes = solver.numNodes();
+		ms = solver.elapsedMs();
+		
+		cout << file << "\t" << cellOrderingName(options.cellOrdering) << "\t" << solver.numNodes() << "\t" << solver.numRestarts() << "\t" << ms << "\t" << statusName(solver.status()) << "\t";
+		solver.stats().print(cout);
+		cout << endl;
+		
+		if(cache != nullptr && solver.status() == SolveStatus::Solved) {
+			cache->store(config->getBoard(), solver.getSolutionPath().front()->getBoard());
+		}
+	}
+};
+
+// Solves every puzzle with every cell ordering (or just the one given) and prints node counts and times side by side
+// Every other option is the same for each run so the orderings can be measured separately
+// The statistics policy decides which extra columns are printed (and what collecting them costs)
+// With a solution cache, puzzles already in it are looked up instead of solved, and new solutions are added to it
+// Puzzles of the standard sizes are solved with fixed-size configs unless dynamic is set
+// With progress set, each solve's progress is kept up to date on stderr
+template <class Stats>
+int benchmark(const vector<string>& files, const vector<CellOrdering>& orderings, const SearchOptions& baseOptions, long maxNodes, long timeoutMs, const RestartSchedule& schedule, SolutionCache* cache, bool dynamic, bool progress) {
+	vector<long long> totalNodes(orderings.size(), 0);
+	vector<double> totalMs(orderings.size(), 0);
+	
+	cout << "puzzle\tordering\tnodes\trestarts\tms\tresult\t" << Stats::columns() << endl;
+	
+	for(const string& file : files) {
+		for(unsigned k = 0; k < orderings.size(); ++k) {
+			SearchOptions options = baseOptions;
+			options.cellOrdering = orderings[k];
+			
+			BenchmarkRun<Stats> run{file, options, maxNodes, timeoutMs, schedule, cache, progress, 0, 0};
+			
+			if(dynamic) {
+				run(make_shared<KakuroConfig>(file));
+			} else {
+				withSizedConfig(KakuroConfig::readBoard(file), false, run);
+			}
+			
+			totalNodes[k] += run.nodes;
+			totalMs[k] += run.ms;
+		}
+	}
+	
+	cout << endl << "ordering\ttotal nodes\ttotal ms" << endl;
+	
+	for(unsigned k = 0; k < orderings.size(); ++k) {
+		cout << cellOrderingName(orderings[k]) << "\t" << totalNodes[k] << "\t" << totalMs[k] << endl;
+	}
+	
+	return 0;
+}
+
+// Races a portfolio of searches on every puzzle, printing which entry won each race and how often each entry won overall
+int portfolio(const vector<string>& files, unsigned size, long maxNodes, long timeoutMs) {
+	vector<PortfolioEntry> entries = defaultPortfolio(size);
+	vector<int> wins(entries.size(), 0);
+	
+	cout << "puzzle\twinner\tresult\tms\twinner nodes\ttotal nodes" << endl;
+	
+	for(const string& file : files) {
+		SolverLimits limits;
+		limits.maxNodes = maxNodes;
+		if(timeoutMs > 0) limits.setTimeout(timeoutMs);
+		
+		PortfolioSolver<KakuroConfig> solver(make_shared<KakuroConfig>(file), entries, limits);
+		int winner = solver.winner();
+		
+		if(winner != -1) ++wins[winner];
+		
+		cout << file << "\t" << (winner != -1 ? entries[winner].name() : "-") << "\t" << statusName(solver.status()) << "\t" << solver.elapsedMs() << "\t";
+		cout << (winner != -1 ? solver.solver(winner).numNodes() : 0) << "\t" << solver.totalNodes() << endl;
+	}
+	
+	cout << endl << "entry\twins" << endl;
+	
+	for(unsigned k = 0; k < entries.size(); ++k) {
+		cout << entries[k].name() << "\t" << wins[k] << endl;
+	}
+	
+	return 0;
+}
+
+// Solves every puzzle with the batch engine and then one by one, printing each puzzle's result and both throughputs
+int batch(const vector<string>& files, long maxNodes, long timeoutMs) {
+	vector<vector<vector<Cell>>> boards;
+	for(const string& file : files) boards.push_back(KakuroConfig::readBoard(file));
+	
+	SolverLimits limits;
+	limits.maxNodes = maxNodes;
+	if(timeoutMs > 0) limits.setTimeout(timeoutMs);
+	
+	auto start = chrono::steady_clock::now();
+	vector<BatchResult> results = BatchSolver::solve(boards, SearchOptions(), limits);
+	double batchMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	
+	start = chrono::steady_clock::now();
+	for(const vector<vector<Cell>>& board : boards) {
+		if(board.empty()) continue;
+		
+		Solver<KakuroConfig, NoStats> solver(make_shared<KakuroConfig>(board, false), limits);
+	}
+	double scalarMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	
+	int searched(0);
+	
+	cout << "puzzle\tresult\tsearched\tnodes" << endl;
+	
+	for(unsigned k = 0; k < files.size(); ++k) {
+		if(results[k].searched) ++searched;
+		
+		cout << files[k] << "\t" << statusName(results[k].status) << "\t" << (results[k].searched ? "yes" : "no") << "\t" << results[k].nodes << endl;
+	}
+	
+	cout << endl << "searched " << searched << " of " << files.size() << endl;
+	cout << "batch\t" << batchMs << " ms\t" << files.size() * 1000.0 / batchMs << " puzzles/s" << endl;
+	cout << "one by one\t" << scalarMs << " ms\t" << files.size() * 1000.0 / scalarMs << " puzzles/s" << endl;
+	
+	return 0;
+}
+
+// Plays a puzzle through by taking hints until it's complete, printing each hint, its rule and how long it took
+int hints(const string& file) {
+	shared_ptr<KakuroConfig> config = make_shared<KakuroConfig>(file);
+	
+	cout << "row\tcol\tvalue\trule\tus" << endl;
+	
+	while(true) {
+		auto start = chrono::steady_clock::now();
+		Hint hint = config->hint();
+		double us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+		
+		if(hint.rule == HintRule::None) break;
+		
+		cout << hint.row << "\t" << hint.col << "\t" << hint.value << "\t" << hintRuleName(hint.rule) << "\t" << us << endl;
+		config->setCell(hint.row, hint.col, hint.value);
+	}
+	
+	bool solved = config->isGoal();
+	cout << (solved ? "solved" : "stuck") << endl;
+	
+	return solved ? 0 : 1;
+}
+
+// Fills a puzzle in with the player's entries from a second board (its values the puzzle doesn't fix), then prints the fewest entries that have to go for it to be solvable and how long finding them took
+int diagnose(const string& puzzleFile, const string& playedFile) {
+	shared_ptr<KakuroConfig> config = make_shared<KakuroConfig>(puzzleFile);
+	vector<vector<Cell>> played = KakuroConfig::readBoard(playedFile);
+	
+	for(unsigned i = 0; i < played.size(); ++i) {
+		for(unsigned j = 0; j < played[i].size(); ++j) {
+			if(played[i][j].isValueCell() && played[i][j].value() > 0) config->setCell(i, j, played[i][j].value());
+		}
+	}
+	
+	auto start = chrono::steady_clock::now();
+	vector<pair<int, int>> conflicts;
+	bool solvable = config->diagnose(conflicts);
+	double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	
+	if(!solvable) {
+		cout << "unsolvable without any entries\t" << ms << " ms" << endl;
+		return 1;
+	}
+	
+	cout << "row\tcol" << endl;
+	for(const pair<int, int>& cell : conflicts) cout << cell.first << "\t" << cell.second << endl;
+	
+	cout << conflicts.size() << " conflicting\t" << ms << " ms" << endl;
+	
+	return 0;
+}
+
+// Reads one generator option at argv[i] (moving i past its value); returns whether argv[i] was one
+bool generatorOption(int argc, char *argv[], int& i, GeneratorOptions& options) {
+	if(i + 1 >= argc) return false;
+	
+	if(strcmp(argv[i], "--density") == 0) {
+		options.density = atof(argv[++i]);
+	} else if(strcmp(argv[i], "--min-run") == 0) {
+		options.minRun = atoi(argv[++i]);
+	} else if(strcmp(argv[i], "--max-run") == 0) {
+		options.maxRun = atoi(argv[++i]);
+	} else if(strcmp(argv[i], "--givens") == 0) {
+		options.givens = atof(argv[++i]);
+	} else if(strcmp(argv[i], "--seed") == 0) {
+		options.seed = strtoul(argv[++i], nullptr, 10);
+	} else {
+		return false;
+	}
+	
+	return true;
+}
+
+// The process's resident memory now and at its peak, in kilobytes
+void memoryUsage(long& currentKb, long& peakKb) {
+	long pages(0), resident(0);
+	ifstream statm("/proc/self/statm");
+	statm >> pages >> resident;
+	currentKb = resident * (sysconf(_SC_PAGESIZE) / 1024);
+	
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	peakKb = usage.ru_maxrss;
+}
+
+// Generates a puzzle of each size (square, in ascending order) and solves it, printing a table of time and memory and charts of both
+// With progress set, each solve's progress is kept up to date on stderr
+int sweep(const vector<unsigned>& sizes, GeneratorOptions options, long maxNodes, long timeoutMs, bool progress) {
+	vector<double> times;
+	vector<long> current, peak;
+	
+	cout << "size\tcells\tgenerate ms\tsolve ms\tresult\tnodes\trss kb\tpeak rss kb" << endl;
+	
+	for(unsigned size : sizes) {
+		options.height = options.width = size;
+		
+		auto start = chrono::steady_clock::now();
+		vector<vector<Cell>> board = BoardGenerator(options).generate();
+		double generateMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+		
+		SolverLimits limits;
+		limits.maxNodes = maxNodes;
+		if(timeoutMs > 0) limits.setTimeout(timeoutMs);
+		if(progress) limits.progress = printProgress(to_string(size) + "x" + to_string(size));
+		
+		start = chrono::steady_clock::now();
+		Solver<KakuroConfig, NoStats> solver(make_shared<KakuroConfig>(board, false), limits);
+		if(progress) cerr << endl;
+		double solveMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+		
+		// Measured while the solver still holds its configs
+		long currentKb, peakKb;
+		memoryUsage(currentKb, peakKb);
+		
+		long cells(0);
+		for(const vector<Cell>& row : board) cells += count_if(row.begin(), row.end(), [](const Cell& c) { return c.isValueCell(); });
+		
+		cout << size << "\t" << cells << "\t" << generateMs << "\t" << solveMs << "\t" << statusName(solver.status()) << "\t" << solver.numNodes() << "\t" << currentKb << "\t" << peakKb << endl;
+		times.push_back(solveMs);
+		current.push_back(currentKb);
+		peak.push_back(peakKb);
+	}
+	
+	if(times.empty()) return 0;
+	
+	// Bars are scaled to the slowest size
+	double slowest = max(*max_element(times.begin(), times.end()), 1e-9);
+	
+	cout << endl << "solve time" << endl;
+	
+	for(unsigned k = 0; k < sizes.size(); ++k) {
+		cout << sizes[k] << "\t" << string(max(1, int(50 * times[k] / slowest)), '#') << " " << times[k] << " ms" << endl;
+	}
+	
+	// Bars are scaled to the most memory seen, current or peak; '#' is the memory held after the solve and '+' runs on to the peak so far
+	long largest = max(max(*max_element(current.begin(), current.end()), *max_element(peak.begin(), peak.end())), 1L);
+	
+	cout << endl << "memory" << endl;
+	
+	for(unsigned k = 0; k < sizes.size(); ++k) {
+		int held = max(1, int(50 * current[k] / largest)), reached = max(held, int(50 * peak[k] / largest));
+		cout << sizes[k] << "\t" << string(held, '#') << string(reached - held, '+') << " " << current[k] << " kb (peak " << peak[k] << " kb)" << endl;
+	}
+	
+	return 0;
+}
+
+// Solves one puzzle, printing how it went and the solution (if any)
+// With a checkpoint file, the search is checkpointed there as it goes; with resume set, it picks up from the checkpoint if there's one of this search
+int solveOne(const string& file, const SearchOptions& options, const SolverLimits& limits, bool resume) {
+	vector<vector<Cell>> board = KakuroConfig::readBoard(file);
+	vector<PuzzleProblem> problems = checkPuzzle(board);
+	
+	if(!problems.empty()) {
+		cout << "result\tinvalid" << endl;
+		for(const PuzzleProblem& problem : problems) cout << describeProblem(problem) << endl;
+		
+		return 1;
+	}
+	
+	shared_ptr<KakuroConfig> config = make_shared<KakuroConfig>(board, false);
+	config->setSearchOptions(options);
+	
+	Checkpoint checkpoint;
+	bool resuming = resume && checkpoint.read(limits.checkpointFile) && checkpoint.matches(config->getBoard(), options);
+	
+	if(resume && !resuming) cerr << "No checkpoint of this search to resume; starting over" << endl;
+	
+	unique_ptr<Solver<KakuroConfig>> solver(resuming ? new Solver<KakuroConfig>(config, checkpoint, limits) : new Solver<KakuroConfig>(config, limits));
+	if(limits.progress) cerr << endl;
+	
+	cout << "result\t" << statusName(solver->status()) << endl;
+	cout << "nodes\t" << solver->numNodes() << endl;
+	cout << "ms\t" << solver->elapsedMs() << endl;
+	
+	if(!limits.checkpointFile.empty()) {
+		cout << "resumed\t" << (resuming ? "yes" : "no") << endl;
+		cout << "checkpoints\t" << solver->numCheckpoints() << endl;
+	}
+	
+	if(solver->status() == SolveStatus::Solved) KakuroConfig::writeBoard(cout, solver->getSolutionPath().front()->getBoard());
+	
+	return solver->status() == SolveStatus::Solved ? 0 : 1;
+}
+
+// Checks every file's clues for problems that leave it no solution, printing each problem and how long the check took
+int checkClues(const vector<string>& files) {
+	int invalid(0);
+	
+	for(const string& file : files) {
+		vector<vector<Cell>> board = KakuroConfig::readBoard(file);
+		
+		auto start = chrono::steady_clock::now();
+		vector<PuzzleProblem> problems = checkPuzzle(board);
+		double us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+		
+		if(!problems.empty()) ++invalid;
+		
+		cout << file << "\t" << (problems.empty() ? "ok" : "invalid") << "\t" << us << " us" << endl;
+		for(const PuzzleProblem& problem : problems) cout << "\t" << describeProblem(problem) << endl;
+	}
+	
+	return invalid > 0 ? 1 : 0;
+}
+
+// Checks complete boards without solving them, printing one verdict per file
+int validate(const vector<string>& files) {
+	int invalid(0);
+	
+	for(const string& file : files) {
+		bool valid = KakuroConfig::isSolution(KakuroConfig::readBoard(file));
+		if(!valid) ++invalid;
+		
+		cout << file << "\t" << (valid ? "valid" : "invalid") << endl;
+	}
+	
+	return invalid > 0 ? 1 : 0;
+}
 
 int main(int argc, char *argv[]) {
+	if(argc > 1 && strcmp(argv[1], "--bench") == 0) {
+		vector<CellOrdering> orderings {CellOrdering::FirstFewest, CellOrdering::MinRemainingDegree, CellOrdering::DomWDeg, CellOrdering::TightestRun};
+		SearchOptions options;
+		long maxNodes(0), timeoutMs(0);
+		RestartSchedule schedule;
+		string traceFile, stats("counting"), cacheFile;
+		bool dynamic(false), progress(false);
+		vector<string> files;
+		
+		for(int i = 2; i < argc; ++i) {
+			if(strcmp(argv[i], "--ordering") == 0 && i + 1 < argc) {
+				CellOrdering ordering;
+				if(!cellOrderingFromName(argv[++i], ordering)) {
+					cerr << "Unknown cell ordering: " << argv[i] << endl;
+					return 1;
+				}
+				
+				orderings = {ordering};
+			} else if(strcmp(argv[i], "--values") == 0 && i + 1 < argc) {
+				if(!valueOrderingFromName(argv[++i], options.valueOrdering)) {
+					cerr << "Unknown value ordering: " << argv[i] << endl;
+					return 1;
+				}
+			} else if(strcmp(argv[i], "--max-nodes") == 0 && i + 1 < argc) {
+				maxNodes = atol(argv[++i]);
+			} else if(strcmp(argv[i], "--timeout-ms") == 0 && i + 1 < argc) {
+				timeoutMs = atol(argv[++i]);
+			} else if(strcmp(argv[i], "--restarts") == 0 && i + 1 < argc) {
+				if(!restartPolicyFromName(argv[++i], schedule.policy)) {
+					cerr << "Unknown restart policy: " << argv[i] << endl;
+					return 1;
+				}
+				
+				// Restarts only help if each attempt breaks its ties differently
+				if(schedule.policy != RestartPolicy::None) options.randomTies = true;
+			} else if(strcmp(argv[i], "--restart-base") == 0 && i + 1 < argc) {
+				schedule.baseNodes = atol(argv[++i]);
+			} else if(strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+				options.seed = strtoul(argv[++i], nullptr, 10);
+				options.randomTies = true;
+			} else if(strcmp(argv[i], "--stats") == 0 && i + 1 < argc) {
+				stats = argv[++i];
+				if(stats != "counting" && stats != "timing" && stats != "none") {
+					cerr << "Unknown statistics policy: " << stats << endl;
+					return 1;
+				}
+			} else if(strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+				cacheFile = argv[++i];
+			} else if(strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+				traceFile = argv[++i];
+			} else if(strcmp(argv[i], "--no-bounds") == 0) {
+				options.propagateBounds = false;
+			} else if(strcmp(argv[i], "--no-combinations") == 0) {
+				options.propagateCombinations = false;
+			} else if(strcmp(argv[i], "--no-decompose") == 0) {
+				options.decompose = false;
+			} else if(strcmp(argv[i], "--dynamic") == 0) {
+				dynamic = true;
+			} else if(strcmp(argv[i], "--progress") == 0) {
+				progress = true;
+			} else {
+				files.push_back(argv[i]);
+			}
+		}
+		
+		if(!traceFile.empty() && !Tracer::getInstance().start(traceFile)) {
+			cerr << "Couldn't open trace file: " << traceFile << endl;
+			return 1;
+		}
+		
+		// Only one process can add to a cache at a time; any others just read from it
+		unique_ptr<SolutionCache> cache;
+		if(!cacheFile.empty()) cache.reset(new SolutionCache(cacheFile, true));
+		
+		int result;
+		
+		if(stats == "none") {
+			result = benchmark<NoStats>(files, orderings, options, maxNodes, timeoutMs, schedule, cache.get(), dynamic, progress);
+		} else if(stats == "timing") {
+			result = benchmark<TimingStats>(files, orderings, options, maxNodes, timeoutMs, schedule, cache.get(), dynamic, progress);
+		} else {
+			// Counting, the default
+			result = benchmark<CountingStats>(files, orderings, options, maxNodes, timeoutMs, schedule, cache.get(), dynamic, progress);
+		}
+		
+		if(!traceFile.empty()) {
+			Tracer::getInstance().stop();
+			if(Tracer::getInstance().dropped() > 0) cerr << Tracer::getInstance().dropped() << " trace events were dropped" << endl;
+		}
+		
+		return result;
+	}
+	
+	if(argc > 2 && strcmp(argv[1], "--trace-report") == 0) {
+		// Folded stacks are cut off at a depth (16 unless given) to keep them readable
+		int maxDepth = argc > 3 ? atoi(argv[3]) : 16;
+		
+		if(!traceReport(argv[2], cout, maxDepth)) {
+			cerr << "Not a trace file: " << argv[2] << endl;
+			return 1;
+		}
+		
+		return 0;
+	}
+	
+	if(argc > 2 && strcmp(argv[1], "--daemon") == 0) {
+		unsigned threads(0);
+		string cacheFile;
+		
+		for(int i = 3; i + 1 < argc; i += 2) {
+			if(strcmp(argv[i], "--threads") == 0) threads = atoi(argv[i + 1]);
+			if(strcmp(argv[i], "--cache") == 0) cacheFile = argv[i + 1];
+		}
+		
+		unique_ptr<SolutionCache> cache;
+		if(!cacheFile.empty()) cache.reset(new SolutionCache(cacheFile, true));
+		
+		SolverDaemon daemon(argv[2], threads, cache.get());
+		return daemon.run() ? 0 : 1;
+	}
+	
+	if(argc > 1 && strcmp(argv[1], "--portfolio") == 0) {
+		// One search per core unless a size is given
+		unsigned size(0);
+		long maxNodes(0), timeoutMs(0);
+		vector<string> files;
+		
+		for(int i = 2; i < argc; ++i) {
+			if(strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+				size = atoi(argv[++i]);
+			} else if(strcmp(argv[i], "--max-nodes") == 0 && i + 1 < argc) {
+				maxNodes = atol(argv[++i]);
+			} else if(strcmp(argv[i], "--timeout-ms") == 0 && i + 1 < argc) {
+				timeoutMs = atol(argv[++i]);
+			} else {
+				files.push_back(argv[i]);
+			}
+		}
+		
+		return portfolio(files, size, maxNodes, timeoutMs);
+	}
+	
+	if(argc > 1 && strcmp(argv[1], "--batch") == 0) {
+		long maxNodes(0), timeoutMs(0);
+		vector<string> files;
+		
+		for(int i = 2; i < argc; ++i) {
+			if(strcmp(argv[i], "--max-nodes") == 0 && i + 1 < argc) {
+				maxNodes = atol(argv[++i]);
+			} else if(strcmp(argv[i], "--timeout-ms") == 0 && i + 1 < argc) {
+				timeoutMs = atol(argv[++i]);
+			} else {
+				files.push_back(argv[i]);
+			}
+		}
+		
+		return batch(files, maxNodes, timeoutMs);
+	}
+	
+	if(argc > 2 && strcmp(argv[1], "--solve") == 0) {
+		SearchOptions options;
+		SolverLimits limits;
+		bool resume(false);
+		
+		for(int i = 3; i < argc; ++i) {
+			if(strcmp(argv[i], "--ordering") == 0 && i + 1 < argc) {
+				if(!cellOrderingFromName(argv[++i], options.cellOrdering)) {
+					cerr << "Unknown cell ordering: " << argv[i] << endl;
+					return 1;
+				}
+			} else if(strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+				options.seed = strtoul(argv[++i], nullptr, 10);
+				options.randomTies = true;
+			} else if(strcmp(argv[i], "--max-nodes") == 0 && i + 1 < argc) {
+				limits.maxNodes = atol(argv[++i]);
+			} else if(strcmp(argv[i], "--timeout-ms") == 0 && i + 1 < argc) {
+				limits.setTimeout(atol(argv[++i]));
+			} else if(strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+				limits.checkpointFile = argv[++i];
+			} else if(strcmp(argv[i], "--checkpoint-ms") == 0 && i + 1 < argc) {
+				limits.checkpointMs = atol(argv[++i]);
+			} else if(strcmp(argv[i], "--resume") == 0) {
+				resume = true;
+			} else if(strcmp(argv[i], "--progress") == 0) {
+				limits.progress = printProgress(argv[2]);
+			} else {
+				cerr << "Unknown solve option: " << argv[i] << endl;
+				return 1;
+			}
+		}
+		
+		return solveOne(argv[2], options, limits, resume);
+	}
+	
+	if(argc > 2 && strcmp(argv[1], "--hint") == 0) {
+		return hints(argv[2]);
+	}
+	
+	if(argc > 3 && strcmp(argv[1], "--diagnose") == 0) {
+		return diagnose(argv[2], argv[3]);
+	}
+	
+	if(argc > 3 && strcmp(argv[1], "--generate") == 0) {
+		GeneratorOptions options;
+		options.height = atoi(argv[2]);
+		options.width = atoi(argv[3]);
+		
+		for(int i = 4; i < argc; ++i) {
+			if(!generatorOption(argc, argv, i, options)) {
+				cerr << "Unknown generator option: " << argv[i] << endl;
+				return 1;
+			}
+		}
+		
+		KakuroConfig::writeBoard(cout, BoardGenerator(options).generate());
+		return 0;
+	}
+	
+	if(argc > 1 && strcmp(argv[1], "--sweep") == 0) {
+		GeneratorOptions options;
+		vector<unsigned> sizes{25, 50, 100};
+		long maxNodes(0), timeoutMs(10000);
+		bool progress(false);
+		
+		for(int i = 2; i < argc; ++i) {
+			if(strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) {
+				sizes.clear();
+				
+				// A comma-separated list
+				for(char* size = strtok(argv[++i], ","); size != nullptr; size = strtok(nullptr, ",")) sizes.push_back(atoi(size));
+			} else if(strcmp(argv[i], "--max-nodes") == 0 && i + 1 < argc) {
+				maxNodes = atol(argv[++i]);
+			} else if(strcmp(argv[i], "--timeout-ms") == 0 && i + 1 < argc) {
+				timeoutMs = atol(argv[++i]);
+			} else if(strcmp(argv[i], "--progress") == 0) {
+				progress = true;
+			} else if(!generatorOption(argc, argv, i, options)) {
+				cerr << "Unknown sweep option: " << argv[i] << endl;
+				return 1;
+			}
+		}
+		
+		sort(sizes.begin(), sizes.end());
+		return sweep(sizes, options, maxNodes, timeoutMs, progress);
+	}
+	
+	if(argc > 1 && strcmp(argv[1], "--check") == 0) {
+		return checkClues(vector<string>(argv + 2, argv + argc));
+	}
+	
+	if(argc > 1 && strcmp(argv[1], "--validate") == 0) {
+		return validate(vector<string>(argv + 2, argv + argc));
+	}
+	
 	QApplication app(argc, argv);
 	PuzzleWindow pw;
 	pw.show();
 	
 	return app.exec();
 }
-
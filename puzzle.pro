@@ -7,14 +7,39 @@ TARGET = Kakuro
 SOURCES += main.cpp \
     PuzzleWindow.cpp \
     KakuroConfig.cpp \
-    Cell.cpp
+    Cell.cpp \
+    RunIndex.cpp \
+    BoardView.cpp \
+    Trace.cpp \
+    SolutionCache.cpp \
+    SolverDaemon.cpp \
+    TiledBoard.cpp \
+    BatchSolver.cpp \
+    BoardGenerator.cpp \
+    Checkpoint.cpp \
+    PuzzleCheck.cpp
 
 HEADERS  += \
     PuzzleWindow.h \
     KakuroConfig.h \
     Cell.h \
     Partitioner.h \
-    Solver.h
+    Solver.h \
+    RunIndex.h \
+    SearchContext.h \
+    BoardView.h \
+    Trace.h \
+    SolverStats.h \
+    SolutionCache.h \
+    SolverDaemon.h \
+    FixedBoard.h \
+    Portfolio.h \
+    BatchSolver.h \
+    BoardGenerator.h \
+    Checkpoint.h \
+    PuzzleCheck.h \
+    TiledBoard.h \
+    TiledVector.h
 
 ICON = kakuro.icns
 